@@ -75,37 +75,20 @@ void add_spikes(Scene *scene) {
 
 /* Spawns a point on the last added platform on the screen aka the highest platform */
 void add_point(Scene *scene, Body *platform) {
-  Body* ball = scene_get_body(scene, 0);
   Body *point = point_init((Vector){body_get_centroid(platform).x, body_get_centroid(platform).y + 8},
   3.0, 20.0, RED, 1);
   scene_add_body(scene, point);
   body_set_velocity(point, DEFAULT_VEL);
   // Creates collisions that destroy the point on collions. Scoring handled in
-  // the CollisionHandler
-  create_player_point_collision(scene, ball, point);
-  for(size_t j = 0; j < scene_bodies(scene); j++){
-    Body* spike = scene_get_body(scene, j);
-    BodyInfo* spike_info = body_get_info(spike);
-    BodyType spike_type = body_info_get_type(spike_info);
-    if(spike_type == SPIKE){
-      create_partial_destructive_collision_with_life(scene, spike, point);
-    }
-  }
-
-
+  // the CollisionHandler. They apply to every point, so only the first point
+  // creates them.
+  create_category_player_point_collision(scene);
+  create_category_partial_destructive_collision_with_life(scene, SPIKE, POINT);
 }
 void add_platform_physics(Scene *scene, Body *platform){
-  for(size_t i = 0; i < scene_bodies(scene); i++){
-      Body* body = scene_get_body(scene, i);
-      BodyInfo* info = body_get_info(body);
-      BodyType type = body_info_get_type(info);
-      if(type == PLAYER){
-          create_player_platform_collision(scene, body, platform);
-      }
-      if(type == SPIKE){
-          create_partial_destructive_collision_with_life(scene, body, platform);
-      }
-  }
+  BodyType type = body_info_get_type(body_get_info(platform));
+  create_category_player_platform_collision(scene, type);
+  create_category_partial_destructive_collision_with_life(scene, SPIKE, type);
 }
 
 Body *add_platform_altitude(Scene *scene, int y, bool trigger) {
@@ -152,16 +135,10 @@ void add_ball_hazard(Scene *scene){
 
 void add_power(Scene *scene, Body *power){
   body_set_velocity(power, DEFAULT_VEL);
-  create_player_powerup_collision(scene, scene_get_body(scene, 0), power);
+  BodyType type = body_info_get_type(body_get_info(power));
+  create_category_player_powerup_collision(scene, type);
   scene_add_body(scene, power);
-  for(size_t i = 0; i < scene_bodies(scene); i++){
-    Body* body = scene_get_body(scene, i);
-    BodyInfo* info = body_get_info(body);
-    BodyType type = body_info_get_type(info);
-    if(type == SPIKE){
-      create_partial_destructive_collision_with_life(scene, body, power);
-    }
-  }
+  create_category_partial_destructive_collision_with_life(scene, SPIKE, type);
 }
 void add_star_invincibility(Scene *scene){
   Body *invincibility = invincibility_init((Vector){randomValue(0, BOUNDARY.x), BOUNDARY.y}, 4.0, 12.0, YELLOW);
@@ -259,7 +236,6 @@ size_t step(Scene *scene, double dt, int last_score, Scene *background, int inv_
 void on_key(char key, KeyEventType type, void* aux_info) {
   Scene *scene = aux_info;
   Body* player = scene_get_body(scene, 0);
-  Body* other = scene_get_body(scene, 1);
   if (type == KEY_PRESSED) {
     switch(key) {
           case LEFT_ARROW:
@@ -273,13 +249,10 @@ void on_key(char key, KeyEventType type, void* aux_info) {
             }
             break;
           case ' ':
-              for(int i = 1; i < scene_bodies(scene); i++){
-                other =  scene_get_body(scene, i);
-                if(find_collision(body_get_shape(player), body_get_shape(other)).collided){
-                  if(!(body_get_velocity(player).y > MAX_VEL.y)){
-                    body_add_impulse(player, IMPULSE_UP);
-                  }
-                  break;
+              // The player can only jump off something it stands on
+              if(body_is_grounded(player)){
+                if(!(body_get_velocity(player).y > MAX_VEL.y)){
+                  body_add_impulse(player, IMPULSE_UP);
                 }
               }
 
@@ -314,22 +287,22 @@ void init_background(Scene * background)
   RGBColor four = (RGBColor){0.854, 0.439, 0.839};
   RGBColor five = (RGBColor){0.933, 0.509, 0.933};
   RGBColor six = (RGBColor){0.827, 0.627, 0.827};
-  List* shape1 = create_block((Vector){0, 25}, (Vector){400, 50});
+  Polygon* shape1 = create_block((Vector){0, 25}, (Vector){400, 50});
   Body* block1 = body_init(shape1, 10, one, 10);
   body_set_velocity(block1, (Vector) {0, DEFAULT_VEL.y/2});
-  List* shape2 = create_block((Vector){0, 75}, (Vector){400, 50});
+  Polygon* shape2 = create_block((Vector){0, 75}, (Vector){400, 50});
   Body* block2 = body_init(shape2, 10, two, 10);
   body_set_velocity(block2, (Vector) {0, DEFAULT_VEL.y/2});
-  List* shape3 = create_block((Vector){0, 125}, (Vector){400, 50});
+  Polygon* shape3 = create_block((Vector){0, 125}, (Vector){400, 50});
   Body* block3 = body_init(shape3, 10, three, 10);
   body_set_velocity(block3, (Vector) {0, DEFAULT_VEL.y/2});
-  List* shape4 = create_block((Vector){0, -125}, (Vector){400, 50});
+  Polygon* shape4 = create_block((Vector){0, -125}, (Vector){400, 50});
   Body* block4 = body_init(shape4, 10, four, 10);
   body_set_velocity(block4, (Vector) {0, DEFAULT_VEL.y/2});
-  List* shape5 = create_block((Vector){0, -75}, (Vector){400, 50});
+  Polygon* shape5 = create_block((Vector){0, -75}, (Vector){400, 50});
   Body* block5 = body_init(shape5, 10, five, 10);
   body_set_velocity(block5, (Vector) {0, DEFAULT_VEL.y/2});
-  List* shape6 = create_block((Vector){0, -25}, (Vector){400, 50});
+  Polygon* shape6 = create_block((Vector){0, -25}, (Vector){400, 50});
   Body* block6 = body_init(shape6, 10, six, 10);
   body_set_velocity(block6, (Vector) {0, DEFAULT_VEL.y/2});
   scene_add_body(background, block1);
@@ -345,9 +318,7 @@ void init_background(Scene * background)
 void draw(Scene *scene, int frame){
     for(size_t i = 0; i < scene_bodies(scene); i++)
     {
-      Body *body = scene_get_body(scene, i);
-      List *polygon = body_get_shape(body);
-      sdl_draw_polygon(polygon, body_get_color(body));
+      sdl_draw_body(scene_get_body(scene, i));
     }
 }
 
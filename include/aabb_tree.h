@@ -0,0 +1,149 @@
+#ifndef __AABB_TREE_H__
+#define __AABB_TREE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "polygon.h"
+
+/**
+ * A dynamic bounding volume hierarchy: a balanced binary tree whose leaves
+ * hold boxes and whose inner nodes hold the box around their children.
+ * Each leaf's box is fattened by a margin, so a box that moves a little stays
+ * inside it and the tree only changes when a box moves further than that.
+ *
+ * Boxes suit this better than a grid when their sizes vary widely, and the
+ * tree also answers which of its boxes overlap any other box.
+ */
+typedef struct aabb_tree AABBTree;
+
+/**
+ * A function called with the id of a box in a tree that overlaps a query.
+ * Takes in an auxiliary value that can store parameters or state.
+ */
+typedef void (*AABBTreeQueryHandler)(size_t id, void *aux);
+
+/**
+ * A function called with the ids of two boxes in trees whose fattened boxes
+ * overlap. Takes in an auxiliary value that can store parameters or state.
+ */
+typedef void (*AABBTreePairHandler)(size_t id1, size_t id2, void *aux);
+
+/**
+ * The margin a tree used as a broad phase fattens boxes by, in scene units.
+ */
+extern const Scalar AABB_TREE_DEFAULT_MARGIN;
+
+/**
+ * Allocates an empty tree.
+ * Asserts that the required memory was allocated.
+ *
+ * @param margin how far every box is fattened by on each side
+ * @return a pointer to the newly allocated tree
+ */
+AABBTree *aabb_tree_init(Scalar margin);
+
+/**
+ * Releases the memory allocated for a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ */
+void aabb_tree_free(AABBTree *tree);
+
+/**
+ * Adds a box to a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param box the box to add
+ * @param id the value to report the box by, e.g. an index
+ * @return a proxy that refers to the box in the tree until it is removed
+ */
+size_t aabb_tree_insert(AABBTree *tree, AABB box, size_t id);
+
+/**
+ * Removes a box from a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy a proxy returned from aabb_tree_insert()
+ */
+void aabb_tree_remove(AABBTree *tree, size_t proxy);
+
+/**
+ * Updates a box in a tree after it has moved. If the box is still inside
+ * its fattened box, nothing changes; otherwise it is fattened again and
+ * reinserted.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy a proxy returned from aabb_tree_insert()
+ * @param box the box's new position
+ * @return whether the box had to be reinserted
+ */
+bool aabb_tree_move(AABBTree *tree, size_t proxy, AABB box);
+
+/**
+ * Gets the id a box was inserted with.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy a proxy returned from aabb_tree_insert()
+ * @return the box's id
+ */
+size_t aabb_tree_get_id(AABBTree *tree, size_t proxy);
+
+/**
+ * Gets the fattened box a tree holds for a box.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param proxy a proxy returned from aabb_tree_insert()
+ * @return the box grown by the tree's margin when it was last reinserted
+ */
+AABB aabb_tree_get_fat_box(AABBTree *tree, size_t proxy);
+
+/**
+ * Gets the number of boxes in a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @return the number of boxes inserted and not removed
+ */
+size_t aabb_tree_size(AABBTree *tree);
+
+/**
+ * Gets the height of a tree, which stays logarithmic in its size.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @return the number of nodes on the longest path from the root to a leaf,
+ *   or 0 if the tree is empty
+ */
+size_t aabb_tree_height(AABBTree *tree);
+
+/**
+ * Calls a handler with the id of every box whose fattened box overlaps a box.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param box the box to look for
+ * @param handler the function to call with each id
+ * @param aux an auxiliary value to pass to handler
+ */
+void aabb_tree_query(AABBTree *tree, AABB box, AABBTreeQueryHandler handler, void *aux);
+
+/**
+ * Calls a handler once with every pair of boxes in a tree whose fattened
+ * boxes overlap, by descending into the tree against itself.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param handler the function to call with each pair's ids
+ * @param aux an auxiliary value to pass to handler
+ */
+void aabb_tree_find_pairs(AABBTree *tree, AABBTreePairHandler handler, void *aux);
+
+/**
+ * Calls a handler with every pair of a box in one tree and a box in another
+ * whose fattened boxes overlap, by descending into both trees together.
+ *
+ * @param tree1 a pointer to a tree returned from aabb_tree_init()
+ * @param tree2 another tree, whose ids are passed second
+ * @param handler the function to call with each pair's ids
+ * @param aux an auxiliary value to pass to handler
+ */
+void aabb_tree_find_pairs_between(AABBTree *tree1, AABBTree *tree2,
+    AABBTreePairHandler handler, void *aux);
+
+#endif // #ifndef __AABB_TREE_H__
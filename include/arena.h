@@ -0,0 +1,107 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stddef.h>
+
+/**
+ * A bump-pointer allocator for short-lived temporaries.
+ * Allocating only advances an offset into a chunk of memory; nothing is freed
+ * individually. Instead, the whole arena is reset at once, or rewound to a mark
+ * taken earlier. Chunks are kept across resets, so once an arena has grown to
+ * its steady-state size it never calls malloc.
+ */
+typedef struct arena Arena;
+
+/**
+ * A position in an arena, returned from arena_mark().
+ */
+typedef struct arena_mark {
+  struct arena_chunk *chunk;
+  size_t used;
+} ArenaMark;
+
+/**
+ * Allocates a new, empty arena.
+ * Asserts that the required memory was allocated.
+ *
+ * @param capacity the number of bytes in the arena's first chunk
+ * @return a pointer to the newly allocated arena
+ */
+Arena *arena_init(size_t capacity);
+
+/**
+ * Releases the memory allocated for an arena, including everything
+ * allocated from it.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ */
+void arena_free(Arena *arena);
+
+/**
+ * Allocates uninitialized, suitably aligned memory from an arena.
+ * The memory stays valid until the arena is reset or rewound past it.
+ * If the current chunk is full, moves on to the next one,
+ * allocating it if needed and asserting that it succeeded.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @param size the number of bytes to allocate
+ * @return a pointer to the allocated memory
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/**
+ * Gets the current position of an arena,
+ * so everything allocated after it can be released with arena_rewind().
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @return the current position
+ */
+ArenaMark arena_mark(Arena *arena);
+
+/**
+ * Releases everything allocated from an arena since a mark was taken.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @param mark a value returned from arena_mark() on the same arena,
+ *   which has not been released by an earlier reset or rewind
+ */
+void arena_rewind(Arena *arena, ArenaMark mark);
+
+/**
+ * Releases everything allocated from an arena.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ */
+void arena_reset(Arena *arena);
+
+/**
+ * Gets the number of bytes an arena has allocated with malloc.
+ *
+ * @param arena a pointer to an arena returned from arena_init()
+ * @return the total capacity of the arena's chunks
+ */
+size_t arena_capacity(Arena *arena);
+
+/**
+ * Gets the arena shared by library code for temporaries that only live for
+ * the current frame. It is created on first use and reset by frame_reset().
+ *
+ * @return the frame arena
+ */
+Arena *frame_arena(void);
+
+/**
+ * Allocates memory from the frame arena. See arena_alloc().
+ *
+ * @param size the number of bytes to allocate
+ * @return a pointer to the allocated memory
+ */
+void *frame_alloc(size_t size);
+
+/**
+ * Releases everything allocated from the frame arena.
+ * Called once per frame by sdl_show().
+ */
+void frame_reset(void);
+
+#endif // #ifndef __ARENA_H__
@@ -7,6 +7,52 @@
 #include "list.h"
 #include "vector.h"
 
+/**
+ * A generational reference to a body.
+ * Every body owns a slot in a global registry; the slot's generation changes
+ * when the body is freed, so a handle held past that point is detected as
+ * stale in constant time instead of dangling.
+ * Handles are passed *by value*, like Vector.
+ */
+typedef struct {
+  size_t index;
+  size_t generation;
+} BodyHandle;
+
+/**
+ * A handle that never refers to a body, e.g. for unused force operands.
+ */
+extern const BodyHandle BODY_HANDLE_NONE;
+
+/**
+ * The collision category of a body that has not been given one,
+ * which no category collision applies to (see scene_add_category_collision()).
+ */
+extern const size_t BODY_NO_CATEGORY;
+
+/**
+ * A body that another touches, as of the last time a scene checked the pair
+ * for a collision.
+ */
+typedef struct {
+  BodyHandle other;
+  // A unit vector pointing from the body towards the other,
+  // along which they collide
+  Vector normal;
+} Contact;
+
+/**
+ * How far below the horizontal a contact's normal must point for the body
+ * to rest on the other one, as the negated y-component of the normal.
+ */
+extern const Scalar BODY_GROUNDED_MIN_SLOPE;
+
+/**
+ * A body's shape relative to its centroid, which may be shared by many bodies.
+ * Defined in shape.h.
+ */
+typedef struct shape_prototype ShapePrototype;
+
 /**
  * A rigid body constrained to the plane.
  * Implemented as a polygon with uniform density.
@@ -14,31 +60,64 @@
  * Angular physics (i.e. torques) are not currently implemented.
  */
 typedef struct body {
-  List *points;
-  double m;
+  // The shape relative to the centroid, before rotating by theta.
+  // Bodies of the same kind and size share one prototype.
+  ShapePrototype *prototype;
+  // The shape in world coordinates, rebuilt from local when it is asked for
+  // after the body has moved or rotated
+  Polygon *points;
+  // The collision level of detail in world coordinates, rebuilt like points;
+  // NULL until asked for, and unused when that level is the full shape
+  Polygon *collision_points;
+  Scalar m;
   RGBColor c;
   Vector vel;
-  double theta;
+  Scalar theta;
   Vector force;
   Vector impulse;
   void *info;
   FreeFunc info_freer;
   bool removed;
-  double radius;
+  Scalar radius;
+  BodyHandle handle;
+  // The position of the body, which local is placed around
+  Vector centroid;
+  // The bounds of the rotated local shape, relative to the centroid
+  AABB local_bounds;
+  // Whether local_bounds must be recomputed, i.e. after a rotation
+  bool bounds_dirty;
+  // Whether points must be rebuilt, i.e. after the body moved or rotated
+  bool world_dirty;
+  // Whether collision_points must be rebuilt, likewise
+  bool collision_dirty;
+  // The prototype's separating axes rotated by theta, rebuilt when asked for
+  // after the body rotated; unused while theta is 0
+  Vector *axes;
+  size_t axes_capacity;
+  bool axes_dirty;
+  // Whether the body collides as a circle of its radius about its centroid
+  // instead of as its polygon
+  bool circle;
+  // Which category collisions the body takes part in, e.g. its BodyType
+  size_t category;
+  // The bodies this one touches, kept up to date by the scene
+  Contact *contacts;
+  size_t contact_count;
+  size_t contact_capacity;
 } Body;
 
 /**
  * Initializes a body without any info.
  * Acts like body_init_with_info() where info and info_freer are NULL.
  */
-Body *body_init(List *shape, double mass, RGBColor color, double radius);
+Body *body_init(Polygon *shape, Scalar mass, RGBColor color, Scalar radius);
 
 /**
  * Allocates memory for a body with the given parameters.
  * The body is initially at rest.
  * Asserts that the mass is positive and that the required memory is allocated.
  *
- * @param shape a list of vectors describing the initial shape of the body
+ * @param shape a polygon describing the initial shape of the body
  * @param mass the mass of the body (if INFINITY, prevents the body from moving)
  * @param color the color of the body, used to draw it on the screen
  * @param info additional information to associate with the body,
@@ -47,8 +126,27 @@ Body *body_init(List *shape, double mass, RGBColor color, double radius);
  * @return a pointer to the newly allocated body
  */
 Body *body_init_with_info(
-    List *shape, double mass, RGBColor color, void *info, FreeFunc info_freer,
-double radius);
+    Polygon *shape, Scalar mass, RGBColor color, void *info, FreeFunc info_freer,
+Scalar radius);
+
+/**
+ * Allocates memory for a body whose shape is a (possibly shared) prototype,
+ * so no vertices are copied. Otherwise acts like body_init_with_info().
+ *
+ * @param prototype the shape of the body; the body takes over the caller's
+ *   reference to it
+ * @param position the position the prototype's shape was built around;
+ *   the centroid is placed at the prototype's offset from it
+ * @param mass the mass of the body (if INFINITY, prevents the body from moving)
+ * @param color the color of the body, used to draw it on the screen
+ * @param info additional information to associate with the body
+ * @param info_freer if non-NULL, a function call on the info to free it
+ * @param radius the radius/ 1/2 y-dimension of the body
+ * @return a pointer to the newly allocated body
+ */
+Body *body_init_with_prototype(
+    ShapePrototype *prototype, Vector position, Scalar mass, RGBColor color,
+    void *info, FreeFunc info_freer, Scalar radius);
 
 /**
  * Releases the memory allocated for a body.
@@ -59,21 +157,151 @@ void body_free(Body *body);
 
 /**
  * Gets the current shape of a body.
- * Returns a newly allocated vector list, which must be list_free()d.
+ * The polygon is owned by the body and must not be freed by the caller.
+ * It must not be modified either, except through the body's setters:
+ * the body keeps its shape relative to its centroid, and only writes the
+ * world-space vertices returned here when they are asked for after the body
+ * has moved, so the polygon is only valid until the body next changes.
  *
  * @param body a pointer to a body returned from body_init()
  * @return the polygon describing the body's current position
  */
-List *body_get_shape(Body *body);
+Polygon *body_get_shape(Body *body);
+
+/**
+ * Gets the shape of a body that collisions are checked against: its
+ * prototype's collision level of detail, placed in the world.
+ * Like body_get_shape(), it is owned by the body and only valid until the
+ * body next changes.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the polygon to check the body's collisions with
+ */
+Polygon *body_get_collision_shape(Body *body);
 
 /**
- * Sets the current shape of a body.
- * Returns a newly allocated vector list, which must be list_free()d.
+ * Gets the separating axes of a body's collision shape: the distinct unit
+ * normals of its edges (see shape_prototype_get_axes()) in world coordinates.
+ * They only depend on the body's rotation, so moving the body keeps them.
+ * Like body_get_shape(), they are owned by the body and only valid until the
+ * body next changes.
  *
  * @param body a pointer to a body returned from body_init()
- * @param new_shape a list of vectors describing the initial shape of the body
+ * @param count where to write the number of axes
+ * @return the unit axes
  */
-void body_set_shape(Body *body, List* new_shape);
+Vector *body_get_axes(Body *body, size_t *count);
+
+/**
+ * Sets whether a body collides as a circle of its radius about its centroid,
+ * which can be checked in closed form, instead of as its polygon.
+ * The polygon is still what is drawn. Bodies are not circles by default.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param circle whether the body is a circle
+ */
+void body_set_circle(Body *body, bool circle);
+
+/**
+ * Returns whether a body collides as a circle; see body_set_circle().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is a circle
+ */
+bool body_is_circle(Body *body);
+
+/**
+ * Sets the collision category of a body, which decides the collisions
+ * a scene checks it for (see scene_add_category_collision()).
+ * Bodies start with BODY_NO_CATEGORY.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param category the body's category, e.g. its BodyType
+ */
+void body_set_category(Body *body, size_t category);
+
+/**
+ * Returns the collision category of a body; see body_set_category().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's category
+ */
+size_t body_get_category(Body *body);
+
+/**
+ * Gets the bodies a body touches. A scene finds these once per tick for the
+ * pairs of bodies it checks for collisions (see scene_add_pair_collision()
+ * and scene_add_category_collision()); other pairs are never contacts.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param count set to the number of contacts
+ * @return the body's contacts, valid until the next scene_tick()
+ */
+Contact *body_get_contacts(Body *body, size_t *count);
+
+/**
+ * Returns whether a body rests on another: whether it touches a body below
+ * it, whose contact normal points down by at least BODY_GROUNDED_MIN_SLOPE.
+ * Takes time proportional to the body's number of contacts.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is grounded
+ */
+bool body_is_grounded(Body *body);
+
+/**
+ * Records that a body touches another, or updates the normal of the contact
+ * if it already did. Called by the scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param other the body it touches
+ * @param normal a unit vector pointing from body towards other
+ */
+void body_set_contact(Body *body, BodyHandle other, Vector normal);
+
+/**
+ * Records that a body no longer touches another. Called by the scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param other the body it touched
+ */
+void body_clear_contact(Body *body, BodyHandle other);
+
+/**
+ * Returns whether a body is an axis-aligned rectangle, i.e. its shape is a box
+ * (see shape_prototype_is_box()) and it is not rotated, so its bounds
+ * (see body_get_bounds()) are exactly its shape.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is a box
+ */
+bool body_is_box(Body *body);
+
+/**
+ * Sets the current shape of a body, freeing the old one.
+ * The new shape is given in world coordinates, and the body takes ownership.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param new_shape a polygon describing the new shape of the body
+ */
+void body_set_shape(Body *body, Polygon* new_shape);
+
+/**
+ * Gets the shape of a body relative to its centroid, before it is rotated.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's prototype, which the caller must not release
+ */
+ShapePrototype *body_get_prototype(Body *body);
+
+/**
+ * Replaces the shape of a body with a (possibly shared) prototype,
+ * keeping its centroid and rotation.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param prototype the new shape; the body takes over the caller's reference
+ */
+void body_set_prototype(Body *body, ShapePrototype *prototype);
 
 /**
  * Gets the current center of mass of a body.
@@ -86,6 +314,34 @@ void body_set_shape(Body *body, List* new_shape);
  */
 Vector body_get_centroid(Body *body);
 
+/**
+ * Gets the area of a body's shape.
+ * Like the centroid, this is cached and only recomputed after the shape changes.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the area of the body's polygon
+ */
+Scalar body_get_area(Body *body);
+
+/**
+ * Gets the axis-aligned bounding box of a body's shape.
+ * This is cached relative to the centroid and moved along with the body,
+ * so it is only recomputed after the shape changes or rotates.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the bounding box of the body's polygon
+ */
+AABB body_get_bounds(Body *body);
+
+/**
+ * Gets the transform that places a body's local shape in the world:
+ * a rotation by the body's angle followed by a translation to its centroid.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's local-to-world transform
+ */
+Transform2D body_get_transform(Body *body);
+
 /**
  * Gets the current velocity of a body.
  *
@@ -100,7 +356,7 @@ Vector body_get_velocity(Body *body);
  * @param body a pointer to a body returned from body_init()
  * @return the mass passed to body_init(), which must be greater than 0
  */
-double body_get_mass(Body *body);
+Scalar body_get_mass(Body *body);
 
 /**
  * Sets the display color of a body.
@@ -132,7 +388,7 @@ void *body_get_info(Body *body);
  * @param body a pointer to a body returned from body_init()
  * @return the radius/ 1/2 y-dimension of a body
  */
-double body_get_radius(Body *body);
+Scalar body_get_radius(Body *body);
 
 /**
  * Translates a body to a new position.
@@ -159,7 +415,7 @@ void body_set_velocity(Body *body, Vector v);
  * @param body a pointer to a body returned from body_init()
  * @param angle the body's new angle in radians. Positive is counterclockwise.
  */
-void body_set_rotation(Body *body, double angle);
+void body_set_rotation(Body *body, Scalar angle);
 
 /**
  * Sets the radius of a body to a new radius
@@ -167,7 +423,7 @@ void body_set_rotation(Body *body, double angle);
  * @param body a pointer to a body returned from body_init()
  * @param new_r the body's new radius
  */
-void body_set_radius(Body *body, double new_r);
+void body_set_radius(Body *body, Scalar new_r);
 
 /**
  * Sets the mass of a body to a new mass
@@ -175,13 +431,13 @@ void body_set_radius(Body *body, double new_r);
  * @param body a pointer to a body returned from body_init()
  * @param mass the body's new mass
  */
-void body_set_mass(Body* body, double mass);
+void body_set_mass(Body* body, Scalar mass);
 
 /* Sets the star body to a new star with the given number of sides */
 void body_star_set_num_sides(Body *body, int sides);
 
-/* Makes a new List * with new radius and num sides */
-void body_star_set_radius_draw(Body *body, double radius, int sides);
+/* Makes a new star Polygon * with new radius and num sides */
+void body_star_set_radius_draw(Body *body, Scalar radius, int sides);
 
 
 /**
@@ -237,7 +493,7 @@ void body_set_impulse(Body* body, Vector impulse);
  * @param body the body to tick
  * @param dt the number of seconds elapsed since the last tick
  */
-void body_tick(Body *body, double dt);
+void body_tick(Body *body, Scalar dt);
 
 /**
  * Marks a body for removal--future calls to body_is_removed() will return true.
@@ -248,6 +504,45 @@ void body_tick(Body *body, double dt);
  */
 void body_remove(Body *body);
 
+/**
+ * Gets the handle of a body, which stays valid until the body is freed.
+ *
+ * @param body a pointer to a body returned from body_init(), or NULL
+ * @return the body's handle, or BODY_HANDLE_NONE if body is NULL
+ */
+BodyHandle body_get_handle(Body *body);
+
+/**
+ * Looks up the body a handle refers to.
+ *
+ * A body marked for removal can still be looked up until it is freed.
+ *
+ * @param handle a handle returned from body_get_handle()
+ * @return the body, or NULL if it has been freed
+ */
+Body *body_from_handle(BodyHandle handle);
+
+/**
+ * Returns whether a handle refers to a body that is neither freed
+ * nor marked for removal.
+ * Takes constant time and never dereferences the body itself.
+ *
+ * @param handle a handle returned from body_get_handle()
+ * @return false once body_remove() or body_free() has been called on the body
+ */
+bool body_handle_is_live(BodyHandle handle);
+
+/**
+ * Returns whether two handles refer to the same body, i.e. to the same slot
+ * in the same generation. Handles to a freed body and to a later body that
+ * reuses its slot are not equal.
+ *
+ * @param handle1 a handle returned from body_get_handle()
+ * @param handle2 another handle
+ * @return whether the handles are the same
+ */
+bool body_handle_equal(BodyHandle handle1, BodyHandle handle2);
+
 /**
  * Returns whether a body has been marked for removal.
  * This function returns false until body_remove() is called on the body,
@@ -0,0 +1,139 @@
+#ifndef __BROAD_PHASE_H__
+#define __BROAD_PHASE_H__
+
+#include <stddef.h>
+#include "polygon.h"
+#include "aabb_tree.h"
+
+/**
+ * Finds the pairs of boxes that overlap among many, without checking every
+ * pair, so that only those pairs need their shapes compared.
+ * The boxes are given again on every call, indexed by id from 0, each with a
+ * key that stays the same from one call to the next; a broad phase may keep
+ * state for each key between calls to make the next one cheaper.
+ */
+typedef struct broad_phase BroadPhase;
+
+/**
+ * The ways a broad phase can find overlapping pairs.
+ */
+typedef enum {
+    // Checks every pair of boxes
+    BROAD_PHASE_ALL_PAIRS,
+    // Sorts the boxes into the cells of a uniform grid and only checks boxes
+    // that share a cell; suits boxes of about the cell size
+    BROAD_PHASE_GRID,
+    // Keeps the boxes sorted by their lower edges on both axes from one call
+    // to the next, and sweeps along the axis they are more spread out on,
+    // only checking boxes whose intervals on that axis overlap; suits rows or
+    // columns of bodies that move little between calls
+    BROAD_PHASE_SWEEP,
+    // Keeps the boxes in a dynamic tree (see aabb_tree.h) from one call to
+    // the next, only moving those that leave their fattened boxes, and finds
+    // pairs by descending into the tree against itself; suits boxes of widely
+    // varying sizes
+    BROAD_PHASE_TREE
+} BroadPhaseKind;
+
+/**
+ * What a broad phase did on its last call.
+ */
+typedef struct broad_phase_stats {
+    // The number of boxes given
+    size_t boxes;
+    // The number of pairs of boxes compared
+    size_t tests;
+    // The number of overlapping pairs found
+    size_t pairs;
+    // The number of swaps needed to sort the boxes again (only for
+    // BROAD_PHASE_SWEEP), or of boxes reinserted into the tree (only for
+    // BROAD_PHASE_TREE)
+    size_t swaps;
+} BroadPhaseStats;
+
+/**
+ * A function called with the ids of every overlapping pair of boxes,
+ * the smaller id first.
+ * Takes in an auxiliary value that can store parameters or state.
+ */
+typedef void (*BroadPhasePairHandler)(size_t id1, size_t id2, void *aux);
+
+/**
+ * The cell size a grid broad phase starts with, in scene units.
+ */
+extern const Scalar BROAD_PHASE_DEFAULT_CELL_SIZE;
+
+/**
+ * Allocates a broad phase of the given kind.
+ * Asserts that the required memory was allocated.
+ *
+ * @param kind how the broad phase finds pairs
+ * @return a pointer to the newly allocated broad phase
+ */
+BroadPhase *broad_phase_init(BroadPhaseKind kind);
+
+/**
+ * Releases the memory allocated for a broad phase.
+ *
+ * @param broad_phase a pointer to a broad phase returned from broad_phase_init()
+ */
+void broad_phase_free(BroadPhase *broad_phase);
+
+/**
+ * Gets how a broad phase finds pairs.
+ *
+ * @param broad_phase a pointer to a broad phase returned from broad_phase_init()
+ * @return the kind passed to broad_phase_init()
+ */
+BroadPhaseKind broad_phase_get_kind(BroadPhase *broad_phase);
+
+/**
+ * Sets the size of the cells of a grid broad phase.
+ * Boxes that would cover more than a few dozen cells are instead checked
+ * against every other box, so the cells should be about as large as
+ * the typical box.
+ *
+ * @param broad_phase a pointer to a broad phase returned from broad_phase_init()
+ * @param cell_size the width and height of each cell; must be positive
+ */
+void broad_phase_set_cell_size(BroadPhase *broad_phase, Scalar cell_size);
+
+/**
+ * Gets the size of the cells of a grid broad phase.
+ *
+ * @param broad_phase a pointer to a broad phase returned from broad_phase_init()
+ * @return the width and height of each cell
+ */
+Scalar broad_phase_get_cell_size(BroadPhase *broad_phase);
+
+/**
+ * Gets what a broad phase did on its last call to broad_phase_find_pairs().
+ *
+ * @param broad_phase a pointer to a broad phase returned from broad_phase_init()
+ * @return the broad phase's statistics, all 0 before the first call
+ */
+BroadPhaseStats broad_phase_get_stats(BroadPhase *broad_phase);
+
+/**
+ * Calls a handler once with every pair of boxes that overlap (see aabb_overlap()).
+ * Pairs are found in an unspecified order.
+ *
+ * A box given with the same key as on the last call is taken to be the same
+ * box having moved, and a key that was not given on the last call to be a new
+ * box, so ids may change freely between calls, e.g. when a box is removed
+ * from the middle, without disturbing the state kept for the other boxes.
+ *
+ * @param broad_phase a pointer to a broad phase returned from broad_phase_init()
+ * @param boxes the boxes, whose ids are their indices
+ * @param keys for each box, a distinct small index that identifies it from one
+ *   call to the next, e.g. the index of a body's handle; if NULL, each box's
+ *   id is its key
+ * @param count the number of boxes
+ * @param handler the function to call with each pair
+ * @param aux an auxiliary value to pass to handler
+ * @return the number of pairs found
+ */
+size_t broad_phase_find_pairs(BroadPhase *broad_phase, AABB *boxes, size_t *keys,
+    size_t count, BroadPhasePairHandler handler, void *aux);
+
+#endif // #ifndef __BROAD_PHASE_H__
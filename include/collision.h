@@ -2,7 +2,7 @@
 #define __COLLISION_H__
 
 #include <stdbool.h>
-#include "list.h"
+#include "polygon.h"
 #include "vector.h"
 #include "body.h"
 
@@ -11,8 +11,8 @@ typedef struct bounding_box BoundingBox;
 
 // The bounds of one dimension of a box
 typedef struct bounds {
-  double min;
-  double max;
+  Scalar min;
+  Scalar max;
 } Bounds;
 
 // The information about the projection
@@ -32,17 +32,62 @@ typedef struct {
      * If the shapes are colliding, the axis they are colliding on.
      * This is a unit vector pointing from the first shape towards the second.
      * Normal impulses are applied along this axis.
-     * If collided is false, this value is undefined.
+     * If collided is false, this is an axis the shapes are apart along
+     * when one was found, and (0, 0) otherwise.
      */
-    double overlap;
+    /**
+     * How far the shapes would have to move apart along the axis to stop
+     * touching. find_collision() leaves it 0.
+     */
+    Scalar overlap;
     Vector axis;
 } CollisionInfo;
 
-// Initializes a bounding box with the given bounds
+/**
+ * A function called when a collision occurs.
+ * @param body1 the first body passed to create_collision()
+ * @param body2 the second body passed to create_collision()
+ * @param axis a unit vector pointing from body1 towards body2
+ *   that defines the direction the two bodies are colliding in
+ * @param aux the auxiliary value passed to create_collision()
+ */
+typedef void (*CollisionHandler)
+    (Body *body1, Body *body2, Vector axis, void *aux);
+
+/**
+ * How the contact between two bodies changed since they were last checked.
+ */
+typedef enum {
+  // The bodies started touching
+  CONTACT_ENTER,
+  // The bodies were touching and still are
+  CONTACT_STAY,
+  // The bodies were touching and no longer are
+  CONTACT_EXIT
+} ContactEvent;
+
+/**
+ * A function that decides what to do each time a check finds two bodies
+ * touching or finds that they have stopped, e.g. to call a handler once
+ * when they start colliding.
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param info the result of checking the bodies
+ * @param event how their contact changed
+ * @param handler the handler the collision was created with
+ * @param aux the auxiliary value to pass to handler
+ */
+typedef void (*CollisionResponse)(Body *body1, Body *body2, CollisionInfo info,
+    ContactEvent event, CollisionHandler handler, void *aux);
+
+// Initializes a bounding box with the given bounds.
+// The box is allocated from the frame arena (see frame_alloc()),
+// so it must not be freed and is only valid until the next frame_reset().
 BoundingBox *bounding_init(Bounds x_bounds, Bounds y_bounds);
 
-// Initializes a bounding box based on the coordinates of the shape
-BoundingBox *find_boundaries(List *shape);
+// Initializes a bounding box based on the coordinates of the shape,
+// allocated from the frame arena like bounding_init()
+BoundingBox *find_boundaries(Polygon *shape);
 
 // Returns the x-bounds of a bounding box
 Bounds get_x_bounds(BoundingBox *bounding_box);
@@ -51,18 +96,189 @@ Bounds get_x_bounds(BoundingBox *bounding_box);
 Bounds get_y_bounds(BoundingBox *bounding_box);
 
 // Finds just the y bounds for a given shape
-Bounds find_y_bounds(List *shape);
+Bounds find_y_bounds(Polygon *shape);
+
+/**
+ * The algorithms two polygons can be checked with.
+ * SAT projects both shapes onto every edge normal, which costs the product of
+ * their vertex counts; GJK and EPA walk the Minkowski difference with support
+ * points instead, which grows with their sum.
+ */
+typedef enum {
+  // GJK for pairs with many vertices between them, SAT otherwise
+  NARROW_PHASE_AUTO,
+  NARROW_PHASE_SAT,
+  NARROW_PHASE_GJK
+} NarrowPhase;
 
 /**
  * Determines whether two convex polygons intersect.
- * The polygons are given as lists of vertices in counterclockwise order.
+ * The polygons are given as vertices in counterclockwise order.
  * There is an edge between each pair of consecutive vertices,
  * and one between the first vertex and the last vertex.
+ * Pairs with many vertices between them are checked with find_gjk_collision().
  *
  * @param shape1 the first shape
  * @param shape2 the second shape
  * @return whether the shapes are colliding
  */
-CollisionInfo find_collision(List *shape1, List *shape2);
+CollisionInfo find_collision(Polygon *shape1, Polygon *shape2);
+
+/**
+ * Gets the box a body collides within: its bounding box (see body_get_bounds()),
+ * or for a body marked as a circle, the box around that circle.
+ * find_body_collision() never reports bodies whose boxes do not overlap.
+ *
+ * @param body the body
+ * @return the body's collision bounds
+ */
+AABB body_collision_bounds(Body *body);
+
+/**
+ * Determines whether the shapes of two bodies intersect, like find_collision(),
+ * but starts from the bodies' cached bounding boxes (see body_get_bounds())
+ * instead of recomputing them from every vertex, and checks the collision
+ * levels of detail of their shapes (see body_get_collision_shape()).
+ * Bodies marked as circles (see body_set_circle()) and axis-aligned boxes
+ * (see body_is_box()) are checked with the closed-form kernels below instead.
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies are colliding
+ */
+CollisionInfo find_body_collision(Body *body1, Body *body2);
+
+/**
+ * Remembers the axis that last separated a pair of bodies, which usually
+ * still separates them on the next tick.
+ * Initialize it as SEPARATING_AXIS_CACHE_EMPTY.
+ */
+typedef struct {
+  bool valid;
+  Vector axis;
+} SeparatingAxisCache;
+
+// A cache that does not hold an axis yet
+#define SEPARATING_AXIS_CACHE_EMPTY ((SeparatingAxisCache){false, {0, 0}})
+
+/**
+ * Counts how well find_body_collision_cached() reuses separating axes.
+ * Pairs whose bounding boxes do not overlap are not counted.
+ */
+typedef struct {
+  // The number of checks that started from a cached axis
+  size_t lookups;
+  // The number of those where the cached axis still separated the bodies
+  size_t hits;
+  // The number of checks that ran the full narrow phase
+  size_t full_checks;
+} SeparatingAxisStats;
+
+/**
+ * Determines whether two bodies collide like find_body_collision(), but
+ * first tests the axis that separated them last time, if any, and only runs
+ * the full check when that axis no longer separates them.
+ * The cache is updated with the axis that separated them this time.
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param cache the pair's cache, which must only be used for these bodies
+ * @param narrow_phase the algorithm to check two polygons with
+ * @return whether the bodies are colliding
+ */
+CollisionInfo find_body_collision_cached(Body *body1, Body *body2, SeparatingAxisCache *cache,
+  NarrowPhase narrow_phase);
+
+/**
+ * Gets the counters of find_body_collision_cached() since the program
+ * started or separating_axis_reset_stats() was last called.
+ *
+ * @return the current counters
+ */
+SeparatingAxisStats separating_axis_get_stats(void);
+
+/**
+ * Resets the counters of find_body_collision_cached() to 0.
+ */
+void separating_axis_reset_stats(void);
+
+/**
+ * Determines whether two convex polygons intersect with GJK, and if they do,
+ * how far and along which axis with EPA (the expanding polytope algorithm).
+ * Each step only needs the vertex of each shape furthest along a direction,
+ * so the cost grows with the sum of the vertex counts rather than their
+ * product as with SAT. Shapes that GJK stops getting any closer to enclosing
+ * the origin for, which are at most touching, are reported as apart.
+ *
+ * @param shape1 the first shape
+ * @param shape2 the second shape
+ * @return whether the shapes are colliding, with the axis pointing from the
+ *   first shape towards the second and how deep they overlap
+ */
+CollisionInfo find_gjk_collision(Polygon *shape1, Polygon *shape2);
+
+/**
+ * Determines whether two circles intersect, in closed form.
+ *
+ * @param center1 the center of the first circle
+ * @param radius1 the radius of the first circle
+ * @param center2 the center of the second circle
+ * @param radius2 the radius of the second circle
+ * @return whether the circles are colliding, with the axis between their
+ *   centers and how deep they overlap
+ */
+CollisionInfo find_circle_collision(Vector center1, Scalar radius1, Vector center2, Scalar radius2);
+
+/**
+ * Determines whether a circle intersects a convex polygon by finding the point
+ * on the polygon closest to the circle's center, which takes one pass over the
+ * edges instead of projecting both shapes onto every edge normal.
+ * The polygon may be in either winding order.
+ *
+ * @param center the center of the circle
+ * @param radius the radius of the circle
+ * @param shape the polygon
+ * @return whether the shapes are colliding, with the axis pointing from the
+ *   circle towards the polygon and how deep they overlap
+ */
+CollisionInfo find_circle_polygon_collision(Vector center, Scalar radius, Polygon *shape);
+
+/**
+ * Determines whether two axis-aligned boxes intersect, by comparing their
+ * extents along the two world axes.
+ *
+ * @param box1 the first box
+ * @param box2 the second box
+ * @return whether the boxes are colliding, with the world axis they overlap
+ *   least along (pointing from the first box towards the second) and how far
+ */
+CollisionInfo find_box_collision(AABB box1, AABB box2);
+
+/**
+ * Determines whether an axis-aligned box intersects a convex polygon.
+ * Only the two world axes and the polygon's own edge normals are tested,
+ * and the box is projected from its center and half extents rather than
+ * vertex by vertex.
+ *
+ * @param box the box
+ * @param shape the polygon
+ * @param axes the polygon's separating axes (see polygon_edge_normals())
+ * @param count the number of axes
+ * @return whether the shapes are colliding, with the axis pointing from the
+ *   box towards the polygon and how deep they overlap
+ */
+CollisionInfo find_box_polygon_collision(AABB box, Polygon *shape, Vector *axes, size_t count);
+
+/**
+ * Determines whether a circle intersects an axis-aligned box, by clamping the
+ * circle's center to the box.
+ *
+ * @param center the center of the circle
+ * @param radius the radius of the circle
+ * @param box the box
+ * @return whether the shapes are colliding, with the axis pointing from the
+ *   circle towards the box and how deep they overlap
+ */
+CollisionInfo find_circle_box_collision(Vector center, Scalar radius, AABB box);
 
 #endif // #ifndef __COLLISION_H__
@@ -5,54 +5,35 @@
 #include "shape.h"
 #include "collision.h"
 
-/**
- * A function called when a collision occurs.
- * @param body1 the first body passed to create_collision()
- * @param body2 the second body passed to create_collision()
- * @param axis a unit vector pointing from body1 towards body2
- *   that defines the direction the two bodies are colliding in
- * @param aux the auxiliary value passed to create_collision()
- */
-typedef void (*CollisionHandler)
-    (Body *body1, Body *body2, Vector axis, void *aux);
-
 typedef struct partial_data{
-  double elasticity;
+  Scalar elasticity;
   bool partial;
 } PartialData;
 
 // Initializer for PartialData
-PartialData *partial_data_init(double elasticity, bool partial);
+PartialData *partial_data_init(Scalar elasticity, bool partial);
+
+/**
+  * Releases memory allocated for PartialData
+  * @param data a pointer to the PartialData to be freed
+  */
+void partial_data_free(PartialData *data);
 
+// The bodies are held by handle, so a force outliving one of them is a no-op
 typedef struct force_data {
-  double force_constant;
-  Body *body1;
-  Body *body2;
+  Scalar force_constant;
+  BodyHandle body1;
+  BodyHandle body2;
 } ForceData;
 
 // Initializer for ForceData
-ForceData *force_data_init(double force_constant, Body *body1, Body *body2);
-
-typedef struct collision_data {
-  //Checks to see if collision has occurred between two bodies before
-  bool colliding;
-  CollisionHandler collision_handler;
-  void *aux;
-  FreeFunc freer;
-  Body *body1;
-  Body *body2;
-} CollisionData;
-
-
-// Initializer for CollisionData
-CollisionData *collision_data_init(CollisionHandler handler, void* aux,
-  bool colliding, FreeFunc freer, Body *body1, Body *body2);
+ForceData *force_data_init(Scalar force_constant, Body *body1, Body *body2);
 
 /**
-  * Releases memory allocated for CollisionData
-  * @param data a pointer to the CollisionData to be freed
+  * Releases memory allocated for ForceData
+  * @param data a pointer to the ForceData to be freed
   */
-void collision_data_free(CollisionData* data);
+void force_data_free(ForceData *data);
 
 /**
  * Adds a Newtonian gravitational force between two bodies in a scene.
@@ -65,7 +46,7 @@ void collision_data_free(CollisionData* data);
  * @param body1 the first body
  * @param body2 the second body
  */
-void create_newtonian_gravity(Scene *scene, double G, Body *body1, Body *body2);
+void create_newtonian_gravity(Scene *scene, Scalar G, Body *body1, Body *body2);
 
 /**
  * Adds a Hooke's-Law spring force between two bodies in a scene.
@@ -76,7 +57,7 @@ void create_newtonian_gravity(Scene *scene, double G, Body *body1, Body *body2);
  * @param body1 the first body
  * @param body2 the second body
  */
-void create_spring(Scene *scene, double k, Body *body1, Body *body2);
+void create_spring(Scene *scene, Scalar k, Body *body1, Body *body2);
 
 /**
  * Adds a drag force on a body proportional to its velocity.
@@ -87,7 +68,7 @@ void create_spring(Scene *scene, double k, Body *body1, Body *body2);
  *   (higher gamma means more drag)
  * @param body the body to slow down
  */
-void create_drag(Scene *scene, double gamma, Body *body);
+void create_drag(Scene *scene, Scalar gamma, Body *body);
 
  /**
  * Adds a ForceCreator to a scene that calls a given CollisionHandler
@@ -96,6 +77,8 @@ void create_drag(Scene *scene, double gamma, Body *body);
  * allowing different things to happen when bodies collide.
  * The handler is passed the bodies, the collision axis, and an auxiliary value.
  * It should only be called once while the bodies are still colliding.
+ * However many collisions are created for the same bodies, the scene only
+ * checks them once per tick; see scene_add_pair_collision().
  *
  * @param scene the scene containing the bodies
  * @param body1 the first body
@@ -141,9 +124,46 @@ void create_destructive_collision(Scene *scene, Body *body1, Body *body2);
  * @param body2 the second body
  */
 void create_physics_collision(
-    Scene *scene, double elasticity, Body *body1, Body *body2
+    Scene *scene, Scalar elasticity, Body *body1, Body *body2
 );
 
+/**
+ * The CollisionResponse of create_collision(): calls the handler when the
+ * bodies start touching, and not again until they have been apart.
+ */
+void collision_respond(Body *body1, Body *body2, CollisionInfo info,
+    ContactEvent event, CollisionHandler handler, void *aux);
+
+/**
+ * Like create_collision(), but for every body of one category (see
+ * body_set_category()) and every body of another, including bodies added later.
+ * Nothing is created per pair of bodies; see scene_add_category_collision().
+ * Asserts that the categories do not collide already, so code that runs each
+ * time a body of either category is added should check
+ * scene_has_category_collision() first.
+ *
+ * @param scene the scene containing the bodies
+ * @param category1 the category of the bodies passed to the handler first
+ * @param category2 the category of the bodies passed to the handler second
+ * @param handler a function to call whenever two such bodies collide
+ * @param aux an auxiliary value to pass to the handler
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void create_category_collision(Scene *scene, size_t category1, size_t category2,
+    CollisionHandler handler, void *aux, FreeFunc freer);
+
+/**
+ * Like create_physics_collision(), but for every body of one category and
+ * every body of another; see create_category_collision().
+ *
+ * @param scene the scene containing the bodies
+ * @param elasticity the "coefficient of restitution" of the collision
+ * @param category1 the first category
+ * @param category2 the second category
+ */
+void create_category_physics_collision(Scene *scene, Scalar elasticity,
+    size_t category1, size_t category2);
+
 /*Extra functionality*/
 
 /**
@@ -156,7 +176,7 @@ void create_physics_collision(
  * @param body the body to add the impulse from collision to
  * @param target the body to be destroyed during collision
  */
-void create_partial_collision(Scene *scene, double elasticity, Body *body, Body *target);
+void create_partial_collision(Scene *scene, Scalar elasticity, Body *body, Body *target);
 
 /**
  * Creates a partial destructive collision in which only a specified body is destroyed
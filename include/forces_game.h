@@ -13,8 +13,30 @@ void create_special_collision(Scene *scene, Body *player, Body *platform,
 CollisionHandler handler, void *aux, FreeFunc freer);
 void create_player_platform_collision(Scene *scene, Body* player, Body* platform);
 void create_partial_destructive_collision_with_life(Scene *scene, Body *object, Body *target);
-void create_partial_collision_with_life(Scene *scene, double elasticity, Body *body, Body *target);
+void create_partial_collision_with_life(Scene *scene, Scalar elasticity, Body *body, Body *target);
 void create_player_point_collision(Scene *scene, Body* player, Body* point);
-void create_player_gravity_collision(Scene *scene, double elasticity, Body* player, Body* grav_ball);
+void create_player_gravity_collision(Scene *scene, Scalar elasticity, Body* player, Body* grav_ball);
 void modulate_velocity(Body* player);
+
+// The CollisionResponse of create_special_collision(). Calls the handler on
+// entering and on every tick of staying in contact while the player is close
+// above the platform, so the handler must be safe to repeat.
+void special_collision_respond(Body *player, Body *platform, CollisionInfo info,
+ContactEvent event, CollisionHandler handler, void *aux);
+
+// Returns whether a body rests on a PLATFORM or PLATFORM_TRIGGER body, as
+// body_is_grounded() does but ignoring every other kind of body below it.
+// Takes time proportional to the body's number of contacts.
+bool body_is_on_platform(Body *body);
+
+// The collisions below are created once for every pair of bodies of two types
+// (see create_category_collision()). create_category_special_collision()
+// asserts that the types do not collide already; the others always create
+// the same collision, so they do nothing if the types already collide.
+void create_category_special_collision(Scene *scene, BodyType player, BodyType platform,
+CollisionHandler handler, void *aux, FreeFunc freer);
+void create_category_player_platform_collision(Scene *scene, BodyType platform);
+void create_category_partial_destructive_collision_with_life(Scene *scene, BodyType object, BodyType target);
+void create_category_partial_collision_with_life(Scene *scene, Scalar elasticity, BodyType body, BodyType target);
+void create_category_player_point_collision(Scene *scene);
 #endif // #ifndef __FORCES_GAME_H__
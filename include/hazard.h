@@ -14,11 +14,11 @@ void gravity_hazard_init(Vector position, Scene* scene);
 //Empty collision type (only collides with spikes, to be destroyed)
 //Exerts gravity on the player
 
-void moving_ball_hazard_init(Vector position, Vector velocity, double mass, Scene* scene);
+void moving_ball_hazard_init(Vector position, Vector velocity, Scalar mass, Scene* scene);
 //physics_collision collision type (spikes still destroy this and are unmoved)
 //Empty force exerted (does not exert a force)
 
-void spring_platforms_hazard_init(Vector position1, Vector position2, Vector dimension, double k, Scene* scene);
+void spring_platforms_hazard_init(Vector position1, Vector position2, Vector dimension, Scalar k, Scene* scene);
 //repel_body collision type, if both platforms touching the player, partial destroy_body
 //Spring force exerted on the other platform (generated in a pair)
 
@@ -1,6 +1,7 @@
 #ifndef __LIST_H__
 #define __LIST_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /**
@@ -16,6 +17,12 @@ typedef struct list List;
  */
 typedef void (*FreeFunc)(void *data);
 
+/**
+ * A function that decides whether a list element should be removed.
+ * Examples: body_is_removed
+ */
+typedef bool (*ListPredicate)(void *data);
+
 /**
  * Allocates memory for a new list with space for the given number of elements.
  * The list is initially empty.
@@ -64,6 +71,35 @@ void *list_get(List *list, size_t index);
  */
 void *list_remove(List *list, size_t index);
 
+/**
+ * Removes the element at a given index in a list and returns it,
+ * moving the last element of the list into its place.
+ * Unlike list_remove(), this takes constant time but does not preserve order;
+ * only elements before the given index are guaranteed to keep their indices.
+ * Asserts that the index is valid, given the list's current size.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param index an index in the list (the first element is at 0)
+ * @return the element at the given index in the list
+ */
+void *list_swap_remove(List *list, size_t index);
+
+/**
+ * Removes every element of a list for which a predicate returns true,
+ * in a single pass over the list.
+ * If preserve_order is true, the remaining elements keep their relative order
+ * (so a prefix of elements that are never removed keeps its indices).
+ * Otherwise, holes are filled with elements taken from the end of the list.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param should_remove a function returning true for elements to remove
+ * @param freer if non-NULL, a function to call on each removed element
+ * @param preserve_order whether the remaining elements must stay in order
+ * @return the number of elements removed
+ */
+size_t list_remove_if(List *list, ListPredicate should_remove, FreeFunc freer,
+  bool preserve_order);
+
 /**
  * Appends an element to the end of a list.
  * If the list is filled to capacity, resizes the list to fit more elements
@@ -1,8 +1,99 @@
 #ifndef __POLYGON_H__
 #define __POLYGON_H__
 
-#include "list.h"
+#include <stddef.h>
 #include "vector.h"
+#include "transform.h"
+
+/**
+ * A growable array of vertices.
+ * Unlike List, the vertices are stored by value in one contiguous block,
+ * so a polygon costs a single allocation no matter how many vertices it has.
+ * The polygon automatically grows its internal array when more capacity is needed.
+ */
+typedef struct polygon Polygon;
+
+/**
+ * An axis-aligned bounding box, given by its bottom left and top right corners.
+ * Passed *by value*, like Vector.
+ */
+typedef struct {
+  Vector min;
+  Vector max;
+} AABB;
+
+/**
+ * Allocates memory for a new polygon with space for the given number of vertices.
+ * The polygon is initially empty.
+ * Asserts that the required memory was allocated.
+ *
+ * @param initial_size the number of vertices to allocate space for
+ * @return a pointer to the newly allocated polygon
+ */
+Polygon *polygon_init(size_t initial_size);
+
+/**
+ * Releases the memory allocated for a polygon.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ */
+void polygon_free(Polygon *polygon);
+
+/**
+ * Gets the number of vertices in a polygon.
+ * Note that this is NOT the polygon's capacity.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return the number of vertices in the polygon
+ */
+size_t polygon_size(Polygon *polygon);
+
+/**
+ * Gets the vertex at a given index in a polygon.
+ * Asserts that the index is valid, given the polygon's current size.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param index an index in the polygon (the first vertex is at 0)
+ * @return the vertex at the given index
+ */
+Vector polygon_get(Polygon *polygon, size_t index);
+
+/**
+ * Replaces the vertex at a given index in a polygon.
+ * Asserts that the index is valid, given the polygon's current size.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param index an index in the polygon (the first vertex is at 0)
+ * @param vertex the new vertex
+ */
+void polygon_set(Polygon *polygon, size_t index, Vector vertex);
+
+/**
+ * Appends a vertex to the end of a polygon.
+ * If the polygon is filled to capacity, resizes it to fit more vertices
+ * and asserts that the resize succeeded.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @param vertex the vertex to add to the end of the polygon
+ */
+void polygon_add(Polygon *polygon, Vector vertex);
+
+/**
+ * Gets the contiguous array backing a polygon, for loops over every vertex.
+ * The array is only valid until the next polygon_add() or polygon_free().
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a pointer to the first of polygon_size() vertices
+ */
+Vector *polygon_vertices(Polygon *polygon);
+
+/**
+ * Allocates a new polygon with the same vertices as the given one.
+ *
+ * @param polygon a pointer to a polygon returned from polygon_init()
+ * @return a pointer to the newly allocated copy
+ */
+Polygon *polygon_copy(Polygon *polygon);
 
 /**
  * Computes the area of a polygon.
@@ -13,7 +104,7 @@
  * each pair of consecutive vertices, plus one between the first and last.
  * @return the area of the polygon
  */
-double polygon_area(List *polygon);
+Scalar polygon_area(Polygon *polygon);
 
 /**
  * Computes the center of mass of a polygon.
@@ -24,7 +115,7 @@ double polygon_area(List *polygon);
  * each pair of consecutive vertices, plus one between the first and last.
  * @return the centroid of the polygon
  */
-Vector polygon_centroid(List *polygon);
+Vector polygon_centroid(Polygon *polygon);
 
 /**
  * Translates all vertices in a polygon by a given vector.
@@ -33,7 +124,7 @@ Vector polygon_centroid(List *polygon);
  * @param polygon the list of vertices that make up the polygon
  * @param translation the vector to add to each vertex's position
  */
-void polygon_translate(List *polygon, Vector translation);
+void polygon_translate(Polygon *polygon, Vector translation);
 
 /**
  * Rotates vertices in a polygon by a given angle about a given point.
@@ -44,6 +135,92 @@ void polygon_translate(List *polygon, Vector translation);
  * A positive angle means counterclockwise.
  * @param point the point to rotate around
  */
-void polygon_rotate(List *polygon, double angle, Vector point);
+void polygon_rotate(Polygon *polygon, Scalar angle, Vector point);
+
+/**
+ * Applies a transform to all vertices in a polygon in a single pass.
+ * Note: mutates the original polygon.
+ *
+ * @param polygon the list of vertices that make up the polygon
+ * @param transform the transform to apply to each vertex
+ */
+void polygon_transform(Polygon *polygon, Transform2D transform);
+
+/**
+ * Overwrites a polygon with the transformed vertices of another,
+ * in a single pass and without allocating unless destination needs to grow.
+ *
+ * @param destination the polygon to write to
+ * @param source the polygon whose vertices are transformed
+ * @param transform the transform to apply to each vertex
+ */
+void polygon_copy_transformed(Polygon *destination, Polygon *source, Transform2D transform);
+
+/**
+ * Computes the unit normals of a polygon's edges, including the edge from the
+ * last vertex back to the first, for use as separating axes.
+ * The normals point outwards if the vertices are in counterclockwise order.
+ * A normal parallel (or opposite) to one already found is skipped, since it
+ * is the same axis, so e.g. a rectangle has 2 and a regular hexagon 3.
+ *
+ * @param polygon the polygon whose edges to use
+ * @param normals where to write the normals; must have room for as many
+ *   normals as the polygon has vertices
+ * @return the number of normals written
+ */
+size_t polygon_edge_normals(Polygon *polygon, Vector *normals);
+
+/**
+ * Returns whether a polygon is convex, i.e. whether every corner turns the
+ * same way (in either winding). Corners where the outline goes straight on
+ * are allowed.
+ *
+ * @param polygon the polygon to check
+ * @return whether the polygon is convex
+ */
+bool polygon_is_convex(Polygon *polygon);
+
+/**
+ * Builds a simplified copy of a polygon by repeatedly dropping the vertex
+ * that lies closest to the line through its two neighbours.
+ * Stops once only min_size vertices are left, or once dropping any other
+ * vertex would move the outline by more than tolerance.
+ * Pass a tolerance of INFINITY to simplify to a vertex count alone,
+ * or a min_size of 3 to simplify to an error bound alone.
+ *
+ * @param polygon the polygon to simplify, which is left unchanged
+ * @param min_size the fewest vertices to keep (at least 3 are always kept)
+ * @param tolerance the furthest dropping a single vertex may move the outline
+ * @return a newly allocated polygon holding a subset of the vertices, in order
+ */
+Polygon *polygon_simplify(Polygon *polygon, size_t min_size, Scalar tolerance);
+
+/**
+ * Computes the smallest axis-aligned box containing a polygon.
+ * Asserts that the polygon is not empty.
+ *
+ * @param polygon the list of vertices that make up the polygon
+ * @return the bounding box of the polygon
+ */
+AABB polygon_bounds(Polygon *polygon);
+
+/**
+ * Translates a bounding box by a given vector.
+ *
+ * @param box the bounding box
+ * @param translation the vector to add to both corners
+ * @return the translated bounding box
+ */
+AABB aabb_translate(AABB box, Vector translation);
+
+/**
+ * Determines whether two bounding boxes overlap.
+ * Boxes that only touch along an edge or corner count as overlapping.
+ *
+ * @param box1 the first bounding box
+ * @param box2 the second bounding box
+ * @return whether the boxes share at least one point
+ */
+bool aabb_overlap(AABB box1, AABB box2);
 
 #endif // #ifndef __POLYGON_H__
@@ -0,0 +1,90 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>
+
+/**
+ * A free-list allocator for objects of one fixed size.
+ * Objects are carved out of blocks that are allocated a whole block at a time,
+ * and released objects are kept on a free list for the next pool_alloc(),
+ * so once a pool has grown to its steady-state size it never calls malloc.
+ *
+ * Every pool is registered by name so its statistics can be looked up with
+ * pool_find() or printed with pool_print_stats().
+ */
+typedef struct pool Pool;
+
+/**
+ * Usage statistics of a pool.
+ */
+typedef struct pool_stats {
+  // The number of objects currently handed out
+  size_t in_use;
+  // The largest in_use has ever been
+  size_t peak_in_use;
+  // The number of objects the allocated blocks can hold
+  size_t capacity;
+  // The number of blocks allocated with malloc
+  size_t blocks;
+  // The number of calls to pool_alloc()
+  size_t total_allocs;
+} PoolStats;
+
+/**
+ * Allocates a new, empty pool and registers it under the given name.
+ * Asserts that the required memory was allocated.
+ *
+ * @param name the name to report statistics under; must outlive the pool
+ * @param object_size the size of every object allocated from the pool
+ * @param block_size the number of objects to allocate space for at a time
+ * @return a pointer to the newly allocated pool
+ */
+Pool *pool_init(const char *name, size_t object_size, size_t block_size);
+
+/**
+ * Releases the memory allocated for a pool, including every object in it,
+ * and unregisters it.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ */
+void pool_free(Pool *pool);
+
+/**
+ * Hands out an uninitialized object from a pool.
+ * If the free list is empty, allocates a new block and asserts that it succeeded.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return a pointer to an object of the pool's object size
+ */
+void *pool_alloc(Pool *pool);
+
+/**
+ * Returns an object to the pool it was allocated from.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @param object a pointer returned from pool_alloc() on the same pool
+ */
+void pool_release(Pool *pool, void *object);
+
+/**
+ * Gets the usage statistics of a pool.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the pool's current statistics
+ */
+PoolStats pool_get_stats(Pool *pool);
+
+/**
+ * Finds a registered pool by name.
+ *
+ * @param name the name passed to pool_init()
+ * @return the pool, or NULL if no pool with that name exists
+ */
+Pool *pool_find(const char *name);
+
+/**
+ * Prints the statistics of every registered pool to stdout.
+ */
+void pool_print_stats(void);
+
+#endif // #ifndef __POOL_H__
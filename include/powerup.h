@@ -15,7 +15,7 @@
  * @returns a pointer to a Body with star shape drawn using Radius with
  * centroid at position, mass, color
  */
-Body *invincibility_init(Vector position, double radius, double mass, RGBColor color);
+Body *invincibility_init(Vector position, Scalar radius, Scalar mass, RGBColor color);
 
 /**
  * Creates a Body with a 5-sided star shape and given parameters representing a
@@ -27,7 +27,7 @@ Body *invincibility_init(Vector position, double radius, double mass, RGBColor c
  * @returns a pointer to a Body with star shape drawn using Radius with
  * centroid at position, mass, color
  */
-Body *expand_init(Vector position, double radius, double mass, RGBColor color);
+Body *expand_init(Vector position, Scalar radius, Scalar mass, RGBColor color);
 
 /**
  * Creates a partial destructive collision between player and powerup stars that
@@ -39,4 +39,13 @@ Body *expand_init(Vector position, double radius, double mass, RGBColor color);
  */
 void create_player_powerup_collision(Scene *scene, Body *player, Body *powerup);
 
+/**
+ * Creates the same collision as create_player_powerup_collision() between every
+ * PLAYER and every powerup of a type (see create_category_collision()),
+ * or does nothing if they already collide
+ * @param scene the scene containing the bodies
+ * @param powerup the BodyType of the powerups
+ */
+void create_category_player_powerup_collision(Scene *scene, BodyType powerup);
+
 #endif // #ifndef __POWERUP_H__
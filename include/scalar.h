@@ -0,0 +1,26 @@
+#ifndef __SCALAR_H__
+#define __SCALAR_H__
+
+/**
+ * The real number type used throughout the library for coordinates, masses,
+ * angles and times. It is a double unless the library is built with
+ * -DSCALAR_FLOAT (make SCALAR=float), in which case it is a float.
+ *
+ * <tgmath.h> is included so that calls like sqrt() or cos() on a Scalar
+ * use the single-precision functions in float builds.
+ */
+#include <tgmath.h>
+
+#ifdef SCALAR_FLOAT
+typedef float Scalar;
+/**
+ * The relative precision that results computed in Scalars can be expected to
+ * agree to, e.g. in tests.
+ */
+#define SCALAR_EPSILON 1e-4
+#else
+typedef double Scalar;
+#define SCALAR_EPSILON 1e-7
+#endif
+
+#endif // #ifndef __SCALAR_H__
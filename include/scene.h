@@ -5,6 +5,14 @@
 #include "body.h"
 #include "list.h"
 #include "status.h"
+#include "broad_phase.h"
+#include "collision.h"
+
+/**
+ * The number of collision categories a scene supports; a body's category
+ * (see body_set_category()) must be below it to take part in category collisions.
+ */
+#define SCENE_CATEGORIES 32
 
 /**
  * A collection of bodies and force creators.
@@ -133,8 +141,155 @@ void scene_add_bodies_force_creator(
     Scene *scene, ForceCreator forcer, void *aux, List *bodies, FreeFunc freer
 );
 
+/**
+ * Adds a force creator that applies to one or two bodies to a scene.
+ * Equivalent to scene_add_bodies_force_creator() with a list of those bodies,
+ * but without allocating the list.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param forcer a force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param body1 the first body affected by the force creator
+ * @param body2 the second body affected by the force creator, or NULL if only
+ *   body1 is affected
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void scene_add_pair_force_creator(
+    Scene *scene, ForceCreator forcer, void *aux, Body *body1, Body *body2, FreeFunc freer
+);
+
+
+/**
+ * Adds a force creator that checks two bodies for a collision to a scene.
+ * Like scene_add_pair_force_creator(), except that the force creator is only
+ * invoked while the scene's broad phase finds the bodies' collision bounds
+ * (see body_collision_bounds()) overlapping, and on the tick after they
+ * separate, so it must do nothing when the bounds do not overlap except
+ * note that the bodies are apart.
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param forcer a force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param body1 the first body affected by the force creator
+ * @param body2 the second body affected by the force creator
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void scene_add_collision_force_creator(
+    Scene *scene, ForceCreator forcer, void *aux, Body *body1, Body *body2, FreeFunc freer
+);
+
+/**
+ * Makes a scene check two bodies for collisions, passing the result of each
+ * check to a response along with a handler when the bodies start touching,
+ * stay touching, or stop touching (see ContactEvent); checks that find them
+ * apart after they already were are not passed on.
+ * Every pair of bodies the scene checks is also part of its contact graph:
+ * once per tick, the scene records on each body the bodies it touches, so
+ * body_get_contacts() and body_is_grounded() need no checks of their own.
+ * A removed body's contacts end without an exit event.
+ * The scene keeps a registry of the pairs of bodies it checks, so a pair is
+ * checked at most once per tick however many collisions are added for it,
+ * including category collisions (see scene_add_category_collision()), and
+ * every one of them responds to the same result.
+ * Like collision force creators, the bodies are only checked while the broad
+ * phase finds their boxes overlapping and on the tick after, and after every
+ * force creator has run. The collision is removed along with either body.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body1 the body passed to the response first
+ * @param body2 the body passed to the response second
+ * @param response the function to call with each check's result
+ * @param handler the handler to pass to response
+ * @param aux an auxiliary value to pass to response
+ * @param freer if non-NULL, a function to call in order to free aux
+ */
+void scene_add_pair_collision(Scene *scene, Body *body1, Body *body2,
+    CollisionResponse response, CollisionHandler handler, void *aux, FreeFunc freer);
+
+/**
+ * Gets how many collisions were added with scene_add_pair_collision() for
+ * a pair of bodies the scene already checked for another collision, each of
+ * which shares that check instead of repeating it.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of such collisions added so far
+ */
+size_t scene_get_duplicate_collisions(Scene *scene);
+
+/**
+ * Makes a scene check every pair of bodies of two categories for collisions,
+ * with one handler for them all, instead of a force creator per pair.
+ * The pairs are checked, and their contacts tracked, as for
+ * scene_add_pair_collision(), sharing the check with any collisions added
+ * for the same pair.
+ * Asserts that the categories do not collide already.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param category1 the category of the bodies passed to the response first
+ * @param category2 the category of the bodies passed to the response second;
+ *   may be category1
+ * @param response the function to call with each check's result
+ * @param handler the handler to pass to response
+ * @param aux an auxiliary value to pass to response
+ * @param freer if non-NULL, a function to call in order to free aux
+ *   when the scene is freed
+ */
+void scene_add_category_collision(Scene *scene, size_t category1, size_t category2,
+    CollisionResponse response, CollisionHandler handler, void *aux, FreeFunc freer);
+
+/**
+ * Returns whether a scene checks bodies of two categories for collisions;
+ * see scene_add_category_collision().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param category1 a category
+ * @param category2 another category, in either order
+ * @return whether a category collision was added for the categories
+ */
+bool scene_has_category_collision(Scene *scene, size_t category1, size_t category2);
+
+/**
+ * Replaces the broad phase a scene finds nearby bodies with at the start of
+ * every tick, keeping its cell size. Scenes start with BROAD_PHASE_GRID.
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param kind how the new broad phase finds pairs
+ */
+void scene_set_broad_phase(Scene *scene, BroadPhaseKind kind);
+
+/**
+ * Gets the broad phase of a scene, e.g. to change its cell size.
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the scene's broad phase, owned by the scene
+ */
+BroadPhase *scene_get_broad_phase(Scene *scene);
+
+/**
+ * Returns whether a scene treats a body as static: one with infinite mass that
+ * is at rest, like a spike or a wall. Static bodies are kept apart from the
+ * broad phase in a tree that is only rebuilt when they change, and pairs of
+ * static bodies are never checked for collisions.
+ * @param body a body
+ * @return whether the body has infinite mass and no velocity
+ */
+bool scene_body_is_static(Body *body);
+
+/**
+ * Gets the number of static bodies (see scene_body_is_static()) a scene found
+ * on the last tick.
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of static bodies
+ */
+size_t scene_get_static_bodies(Scene *scene);
+
+/**
+ * Gets the number of pairs of bodies whose collision bounds the broad phase
+ * (or the static tree) found overlapping on the last tick, whether or not
+ * they can collide.
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of overlapping pairs
+ */
+size_t scene_get_broad_phase_pairs(Scene *scene);
 
-void scene_background_tick(Scene * scene, double dt, Vector max);
+void scene_background_tick(Scene * scene, Scalar dt, Vector max);
 
 
 /**
@@ -147,5 +302,5 @@ void scene_background_tick(Scene * scene, double dt, Vector max);
  * @param scene a pointer to a scene returned from scene_init()
  * @param dt the time elapsed since the last tick, in seconds
  */
-void scene_tick(Scene *scene, double dt);
+void scene_tick(Scene *scene, Scalar dt);
 #endif // #ifndef __SCENE_H__
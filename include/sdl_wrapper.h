@@ -3,7 +3,7 @@
 
 #include <stdbool.h>
 #include "color.h"
-#include "list.h"
+#include "polygon.h"
 #include "scene.h"
 #include "vector.h"
 
@@ -63,20 +63,47 @@ void sdl_clear(void);
 /**
  * Draws a polygon from the given list of vertices and a color.
  *
- * @param points the list of vertices of the polygon
+ * @param points the vertices of the polygon
  * @param color the color used to fill in the polygon
  */
-void sdl_draw_polygon(List *points, RGBColor color);
+void sdl_draw_polygon(Polygon *points, RGBColor color);
+
+/**
+ * Draws a polygon after applying a transform to each of its vertices,
+ * e.g. a body's local shape.
+ *
+ * @param points the vertices of the polygon
+ * @param transform the transform that places the vertices in the scene
+ * @param color the color used to fill in the polygon
+ */
+void sdl_draw_polygon_transformed(Polygon *points, Transform2D transform, RGBColor color);
+
+/**
+ * Draws a body in its color, using the coarsest level of detail of its shape
+ * that looks the same at the current scale (see shape_prototype_get_render_lod()).
+ *
+ * @param body the body to draw
+ */
+void sdl_draw_body(Body *body);
+
+/**
+ * Gets the number of pixels one unit of the scene is drawn as,
+ * so that the whole scene fits in the window.
+ *
+ * @return the current scale
+ */
+double sdl_get_scale(void);
 
 /**
  * Displays the rendered frame on the SDL window.
  * Must be called after drawing the polygons in order to show them.
+ * Ends the frame by resetting the frame arena (see frame_reset()).
  */
 void sdl_show(void);
 
 /**
  * Draws all bodies in a scene.
- * This internally calls sdl_clear(), sdl_draw_polygon(), and sdl_show(),
+ * This internally calls sdl_clear(), sdl_draw_body(), and sdl_show(),
  * so those functions should not be called directly.
  *
  * @param scene the scene to draw
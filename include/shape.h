@@ -20,12 +20,203 @@ typedef enum {
     BOUND
 } BodyType;
 
+/**
+ * The kinds of shape prototypes; CUSTOM ones are built from an arbitrary
+ * polygon and never registered.
+ */
+typedef enum {
+    SHAPE_CUSTOM,
+    SHAPE_STAR,
+    SHAPE_BLOCK,
+    SHAPE_BALL
+} ShapeKind;
+
+/**
+ * Creates an unregistered prototype from a polygon that is already relative
+ * to its centroid, and precomputes its area and bounds.
+ * Asserts that the required memory was allocated.
+ *
+ * @param local the shape, which the prototype takes ownership of
+ * @return a prototype holding one reference
+ */
+ShapePrototype *shape_prototype_init(Polygon *local);
+
+/**
+ * Takes another reference to a prototype.
+ *
+ * @param prototype a prototype
+ * @return the same prototype
+ */
+ShapePrototype *shape_prototype_retain(ShapePrototype *prototype);
+
+/**
+ * Drops a reference to a prototype, freeing it when none are left.
+ *
+ * @param prototype a prototype
+ */
+void shape_prototype_release(ShapePrototype *prototype);
+
+/**
+ * Gets the shape of a prototype, relative to its centroid.
+ * The polygon is shared and must not be modified or freed.
+ *
+ * @param prototype a prototype
+ * @return the prototype's polygon
+ */
+Polygon *shape_prototype_get_polygon(ShapePrototype *prototype);
+
+/**
+ * Gets the precomputed area of a prototype.
+ *
+ * @param prototype a prototype
+ * @return the area of the prototype's polygon
+ */
+Scalar shape_prototype_get_area(ShapePrototype *prototype);
+
+/**
+ * Gets the precomputed bounding box of a prototype, relative to its centroid.
+ *
+ * @param prototype a prototype
+ * @return the bounds of the prototype's polygon
+ */
+AABB shape_prototype_get_bounds(ShapePrototype *prototype);
+
+/**
+ * Gets where the centroid of a prototype lies relative to the point its shape
+ * was built around, e.g. a ball whose last vertex falls short of a full turn
+ * is not quite centered on its position.
+ *
+ * @param prototype a prototype
+ * @return the offset of the centroid
+ */
+Vector shape_prototype_get_offset(ShapePrototype *prototype);
+
+/**
+ * Gets the kind of shape a prototype was built as.
+ *
+ * @param prototype a prototype
+ * @return the kind passed when it was registered, or SHAPE_CUSTOM
+ */
+ShapeKind shape_prototype_get_kind(ShapePrototype *prototype);
+
+/**
+ * Returns whether a prototype is an axis-aligned rectangle, like every shape
+ * made by create_block(), which collisions can treat as its bounding box.
+ *
+ * @param prototype a prototype
+ * @return whether the prototype is a box
+ */
+bool shape_prototype_is_box(ShapePrototype *prototype);
+
+/**
+ * Gets the simplified shape of a prototype that collisions are checked
+ * against, which drops vertices that barely change the outline, e.g. most of
+ * a ball's. It is relative to the centroid, shared, and must not be modified.
+ *
+ * @param prototype a prototype
+ * @return the collision level of detail, possibly the full shape itself
+ */
+Polygon *shape_prototype_get_collision_lod(ShapePrototype *prototype);
+
+/**
+ * Gets the separating axes of a prototype's collision level of detail
+ * (see polygon_edge_normals()), computed once and shared like its shape.
+ *
+ * @param prototype a prototype
+ * @param count where to write the number of axes
+ * @return the unit axes, which must not be modified or freed
+ */
+Vector *shape_prototype_get_axes(ShapePrototype *prototype, size_t *count);
+
+/**
+ * A convex part of a prototype's collision shape, relative to the prototype's
+ * centroid like the shape itself.
+ */
+typedef struct {
+  // The part's outline, wound the same way as the whole shape
+  Polygon *shape;
+  // The part's separating axes (see polygon_edge_normals())
+  Vector *axes;
+  size_t axis_count;
+  // A circle around the part, which is checked before the part itself
+  Vector center;
+  Scalar radius;
+} ShapePiece;
+
+/**
+ * Gets the convex pieces that a prototype's collision level of detail is split
+ * into, computed once and shared like its shape.
+ * A concave shape whose vertices can all be seen from its centroid, like a
+ * star, is cut into fans around the centroid at its inward corners; a convex
+ * shape (or any other concave one) is a single piece, the shape itself.
+ *
+ * @param prototype a prototype
+ * @param count where to write the number of pieces
+ * @return the pieces, which must not be modified or freed
+ */
+ShapePiece *shape_prototype_get_pieces(ShapePrototype *prototype, size_t *count);
+
+/**
+ * Gets the coarsest simplified shape of a prototype that still looks the same
+ * when drawn at the given scale, so small bodies are drawn with few vertices.
+ * It is relative to the centroid, shared, and must not be modified.
+ *
+ * @param prototype a prototype
+ * @param pixels_per_unit the size on screen of one unit in the scene
+ * @return the render level of detail, possibly the full shape itself
+ */
+Polygon *shape_prototype_get_render_lod(ShapePrototype *prototype, Scalar pixels_per_unit);
+
+/**
+ * Looks up the registered star prototype with the given sides and radius,
+ * building and registering it if no body uses one yet.
+ * Takes constant time on average.
+ *
+ * @param sides number of points on the star
+ * @param radius radius of the star
+ * @return a new reference to the prototype
+ */
+ShapePrototype *shape_prototype_star(int sides, Scalar radius);
+
+/**
+ * Looks up the registered block prototype with the given dimension,
+ * building and registering it if no body uses one yet.
+ * Takes constant time on average.
+ *
+ * @param dimension the width and height of the block
+ * @return a new reference to the prototype
+ */
+ShapePrototype *shape_prototype_block(Vector dimension);
+
+/**
+ * Looks up the registered ball prototype with the given radius,
+ * building and registering it if no body uses one yet.
+ * Takes constant time on average.
+ *
+ * @param radius radius of the ball
+ * @return a new reference to the prototype
+ */
+ShapePrototype *shape_prototype_ball(Scalar radius);
+
+/**
+ * Gets the number of prototypes in the registry.
+ * The registry holds no references: a prototype leaves it when its last
+ * reference is released, so this is the number of distinct shapes in use.
+ */
+size_t shape_prototype_count(void);
+
+/**
+ * Empties the registry. Prototypes still used by bodies are freed along with
+ * their last body, but are no longer shared with bodies created afterwards.
+ */
+void shape_prototype_clear(void);
+
 // Defines a body_info struct to be passed in Body
 typedef struct body_info BodyInfo;
 
 /* Initializes a star shape given a position vector, its dimensinos, color and
 the number of lives */
-BodyInfo* body_info_init(BodyType* type, size_t life);
+BodyInfo* body_info_init(BodyType type, size_t life);
 
 /**
  * Releases memory allocated for a BodyInfo
@@ -47,13 +238,6 @@ BodyType body_info_get_type(BodyInfo* info);
  */
 size_t body_info_get_life(BodyInfo* info);
 
-/**
- * Returns whether or not the body is in collision
- * @param info a pointer to a BodyInfo
- * @return TRUE or FALSE depending on whether the Body is in collision
- */
-bool body_info_get_collision(BodyInfo* info);
-
 bool body_info_get_life_lock(BodyInfo* info);
 
 /**
@@ -63,13 +247,6 @@ bool body_info_get_life_lock(BodyInfo* info);
  */
 void body_info_set_life(BodyInfo* info, size_t new_life);
 
-/**
- * Sets whether or not the body is currently in collision with another body
- * @param info a pointer to a BodyInfo
- * @param colliding either TRUE or FALSE will be set here
- */
-void body_info_set_collision(BodyInfo* info, bool colliding);
-
 void body_info_set_life_lock(BodyInfo* info, bool lock);
 
 /**
@@ -80,17 +257,17 @@ void body_info_set_life_lock(BodyInfo* info, bool lock);
  * @param mass the mass of the star
  * @param RGBColor the color of the star
  * @param life the number of lives the star has
- * @param type the BodyType of the star
+ * @param type the BodyType of the star, which is also its collision category
  * @returns a Body with star shape of specified type with centroid at position, mass, color and
  * number of lives
  */
-Body *star_init(int sides, Vector position, double radius, double mass, RGBColor color, size_t life, BodyType* type);
+Body *star_init(int sides, Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life, BodyType type);
 
 // Calls on star_init to create a PLAYER type star
-Body *player_init(int sides, Vector position, double radius, double mass, RGBColor color, size_t life);
+Body *player_init(int sides, Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life);
 
 // Draws a block at the given position with the given dimension.
-List *create_block(Vector position, Vector dimension);
+Polygon *create_block(Vector position, Vector dimension);
 
 
 /**
@@ -126,21 +303,22 @@ Body *boundary_init(Vector position, Vector dimension, RGBColor color, size_t li
  * @param mass the mass of the star
  * @param RGBColor the color of the star
  * @param life the number of lives the star has
-* @param type the BodyType of the ball (PLAYER, MOVING_BALL, GRAVITY_BALL)
+* @param type the BodyType of the ball (PLAYER, MOVING_BALL, GRAVITY_BALL),
+*   which is also its collision category
  */
-Body *ball_init(Vector position, double radius, double mass, RGBColor color, size_t life, BodyType* type);
+Body *ball_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life, BodyType type);
 
 // Initializes a POINT type ball using ball_init
-Body *point_init(Vector position, double radius, double mass, RGBColor color, size_t life);
+Body *point_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life);
 
 // Initializes a GRAVITY_BALL type hazard ball using ball_init
-Body *gravity_ball_init(Vector position, double radius, double mass, RGBColor color, size_t life);
+Body *gravity_ball_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life);
 
 // Initializes a MOVING_BALL type hazard ball using ball_init
-Body *moving_ball_init(Vector position, double radius, double mass, RGBColor color, size_t life);
+Body *moving_ball_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life);
 
 // Create a star shape that acts as the visual in counterclockwise
-List *create_star(int sides, Vector position, double radius);
+Polygon *create_star(int sides, Vector position, Scalar radius);
 
 /**
  * Creates a Body with a spike shape and given parameters representing SPIKE type
@@ -151,7 +329,7 @@ List *create_star(int sides, Vector position, double radius);
  * @param RGBColor the color of the star
  * @param life the number of lives the star has
  */
-Body *spike_init(Vector position, double radius, double mass, RGBColor color, size_t life);
+Body *spike_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life);
 
  /**
   * Draws the specified Shape using sdl_draw_polygon
@@ -0,0 +1,74 @@
+#ifndef __SIMD_H__
+#define __SIMD_H__
+
+#include <stddef.h>
+#include "vector.h"
+
+/**
+ * Kernels that operate on contiguous arrays of vertices,
+ * such as the ones returned from polygon_vertices().
+ *
+ * Which implementation is used is selected at compile time:
+ * AVX2 when compiled with -mavx2, otherwise SSE2 on x86-64,
+ * and a scalar loop everywhere else or when SIMD_SCALAR is defined.
+ * Every implementation produces the same results as the scalar loop.
+ */
+
+/**
+ * Gets the name of the kernel implementation that was compiled in.
+ *
+ * @return "avx2", "sse2" or "scalar"
+ */
+const char *simd_implementation(void);
+
+/**
+ * Translates every vertex of an array in place.
+ *
+ * @param vertices the array of vertices
+ * @param size the number of vertices in the array
+ * @param translation the vector to add to every vertex
+ */
+void simd_translate(Vector *vertices, size_t size, Vector translation);
+
+/**
+ * Rotates every vertex of an array about the origin and then translates it,
+ * given the cosine and sine of the angle so they are only computed once.
+ * This is how a Transform2D is applied to an array.
+ *
+ * @param source the array of vertices to transform
+ * @param destination the array to write the transformed vertices to,
+ *   which may be source itself
+ * @param size the number of vertices in the arrays
+ * @param cos_angle the cosine of the angle to rotate counterclockwise by
+ * @param sin_angle the sine of the angle to rotate counterclockwise by
+ * @param translation the vector to add to every vertex after rotating it
+ */
+void simd_transform(const Vector *source, Vector *destination, size_t size,
+    Scalar cos_angle, Scalar sin_angle, Vector translation);
+
+/**
+ * Finds the smallest and largest dot product of an axis with the vertices of
+ * an array, i.e. the projection of the vertices on the axis.
+ * Asserts that the array is not empty.
+ *
+ * @param vertices the array of vertices
+ * @param size the number of vertices in the array
+ * @param axis the axis to project on
+ * @param min set to the smallest dot product
+ * @param max set to the largest dot product
+ */
+void simd_project(const Vector *vertices, size_t size, Vector axis, Scalar *min, Scalar *max);
+
+/**
+ * Finds the componentwise smallest and largest coordinates of the vertices of
+ * an array, i.e. their axis-aligned bounding box.
+ * Asserts that the array is not empty.
+ *
+ * @param vertices the array of vertices
+ * @param size the number of vertices in the array
+ * @param min set to the smallest x and y coordinates
+ * @param max set to the largest x and y coordinates
+ */
+void simd_bounds(const Vector *vertices, size_t size, Vector *min, Vector *max);
+
+#endif // #ifndef __SIMD_H__
@@ -6,9 +6,32 @@
 #include <stdio.h>
 #include <string.h>
 
+/**
+ * The time step and number of steps for tests that integrate over one second.
+ * Single precision cannot resolve steps as small as 10 ** -6 against
+ * coordinates near 1, so float builds (see scalar.h) take larger steps.
+ */
+#ifdef SCALAR_FLOAT
+#define TEST_DT 1e-5
+#define TEST_STEPS 100000
+#else
+#define TEST_DT 1e-6
+#define TEST_STEPS 1000000
+#endif
+
+/**
+ * The additional error that integrating with TEST_DT accumulates,
+ * to be added to the tolerance of tests that check integrated quantities.
+ */
+#ifdef SCALAR_FLOAT
+#define TEST_DRIFT 2e-3
+#else
+#define TEST_DRIFT 0
+#endif
+
 /**
  * Returns whether two double values are nearly equal,
- * i.e. within 10 ** -7 of each other.
+ * i.e. within SCALAR_EPSILON (10 ** -7 in double builds) of each other.
  * Floating-point math is approximate, so isclose() is preferable to ==.
  * There are some exceptions: ints (<= 53 bits) and fractions whose denominators
  * are powers of 2 (e.g. 0.5 or 0.75) can be represented exactly as a double.
@@ -33,6 +56,8 @@ bool vec_isclose(Vector v1, Vector v2);
 /**
  * Returns whether two double values are nearly equal,
  * where the acceptable difference is specified by epsilon.
+ * In float builds (see scalar.h), epsilon is relative to the larger magnitude
+ * of the two values once that exceeds 1.
  */
 bool within(double epsilon, double d1, double d2);
 
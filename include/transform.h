@@ -0,0 +1,82 @@
+#ifndef __TRANSFORM_H__
+#define __TRANSFORM_H__
+
+#include <stddef.h>
+#include "vector.h"
+
+/**
+ * A rigid transformation of the plane: a rotation followed by a translation.
+ * The rotation is stored as its cosine and sine, so applying a transform
+ * to any number of vectors never calls the trig functions.
+ * Like Vector, it is small and passed by value.
+ */
+typedef struct {
+    /** The cosine of the counterclockwise rotation angle */
+    Scalar cos_angle;
+    /** The sine of the counterclockwise rotation angle */
+    Scalar sin_angle;
+    /** The vector added after rotating */
+    Vector translation;
+} Transform2D;
+
+/**
+ * The transform that leaves every vector unchanged.
+ */
+extern const Transform2D TRANSFORM_IDENTITY;
+
+/**
+ * Creates a transform that only translates.
+ *
+ * @param translation the vector to add
+ * @return the transform v -> v + translation
+ */
+Transform2D transform_translation(Vector translation);
+
+/**
+ * Creates a transform that rotates about a point.
+ * This is the only place the trig functions are evaluated.
+ *
+ * @param angle the angle to rotate by, in radians.
+ * A positive angle means counterclockwise.
+ * @param point the point to rotate around, which the transform leaves fixed
+ * @return the transform that rotates by angle about point
+ */
+Transform2D transform_rotation(Scalar angle, Vector point);
+
+/**
+ * Composes two transforms.
+ *
+ * @param outer the transform to apply second
+ * @param inner the transform to apply first
+ * @return the transform v -> outer(inner(v))
+ */
+Transform2D transform_compose(Transform2D outer, Transform2D inner);
+
+/**
+ * Inverts a transform.
+ *
+ * @param transform the transform to invert
+ * @return the transform that undoes transform
+ */
+Transform2D transform_invert(Transform2D transform);
+
+/**
+ * Applies a transform to a vector.
+ *
+ * @param transform the transform to apply
+ * @param v the vector to transform
+ * @return the transformed vector
+ */
+Vector transform_apply(Transform2D transform, Vector v);
+
+/**
+ * Applies a transform to every vector of an array in place,
+ * in a single pass (see simd_transform()).
+ *
+ * @param transform the transform to apply
+ * @param vertices the array of vectors
+ * @param size the number of vectors in the array
+ */
+void transform_apply_array(Transform2D transform, Vector *vertices, size_t size);
+
+#endif // #ifndef __TRANSFORM_H__
@@ -1,14 +1,15 @@
 #ifndef __VECTOR_H__
 #define __VECTOR_H__
 #include <stdbool.h>
+#include "scalar.h"
 /**
  * A real-valued 2-dimensional vector.
  * Positive x is towards the right; positive y is towards the top.
  * Vector is defined here instead of vector.c because it is passed *by value*.
  */
 typedef struct {
-    double x;
-    double y;
+    Scalar x;
+    Scalar y;
 } Vector;
 
 /**
@@ -57,7 +58,7 @@ Vector vec_negate(Vector v);
  * @param v the vector to scale
  * @return scalar * v
  */
-Vector vec_multiply(double scalar, Vector v);
+Vector vec_multiply(Scalar scalar, Vector v);
 
 /**
  * Computes the dot product of two vectors.
@@ -67,15 +68,15 @@ Vector vec_multiply(double scalar, Vector v);
  * @param v2 the second vector
  * @return v1 . v2
  */
-double vec_dot(Vector v1, Vector v2);
+Scalar vec_dot(Vector v1, Vector v2);
 
-double vec_get_x(Vector v);
+Scalar vec_get_x(Vector v);
 
-double vec_get_y(Vector v);
+Scalar vec_get_y(Vector v);
 
 bool vec_equal(Vector x, Vector y);
 
-double vec_magnitude(Vector v);
+Scalar vec_magnitude(Vector v);
 /**
  * Computes the cross product of two vectors,
  * which lies along the z-axis.
@@ -85,7 +86,7 @@ double vec_magnitude(Vector v);
  * @param v2 the second vector
  * @return the z-component of v1 x v2
  */
-double vec_cross(Vector v1, Vector v2);
+Scalar vec_cross(Vector v1, Vector v2);
 
 /**
  * Rotates a vector by an angle around (0, 0).
@@ -99,6 +100,6 @@ double vec_cross(Vector v1, Vector v2);
  * @param angle the angle to rotate the vector
  * @return v rotated by the given angle
  */
-Vector vec_rotate(Vector v, double angle);
+Vector vec_rotate(Vector v, Scalar angle);
 
 #endif // #ifndef __VECTOR_H__
@@ -0,0 +1,359 @@
+#include "aabb_tree.h"
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+const Scalar AABB_TREE_DEFAULT_MARGIN = 1;
+// The number of nodes a tree allocates space for at first
+const size_t AABB_TREE_INITIAL_NODES = 16;
+// Marks the absence of a node
+#define AABB_TREE_NULL SIZE_MAX
+
+// A node is a leaf if it has no children, and on the free list if its
+// height is negative, in which case next holds the next free node
+typedef struct aabb_tree_node {
+  AABB box;
+  size_t parent;
+  size_t next;
+  size_t child1;
+  size_t child2;
+  // 0 for a leaf
+  int height;
+  size_t id;
+} AABBTreeNode;
+
+struct aabb_tree {
+  Scalar margin;
+  size_t root;
+  // Every node, whether in the tree or free; proxies index into this
+  AABBTreeNode *nodes;
+  size_t capacity;
+  size_t free_list;
+  size_t size;
+};
+
+// Puts nodes first to capacity on the free list
+void aabb_tree_free_nodes(AABBTree *tree, size_t first){
+  for(size_t i = first; i < tree->capacity; i++){
+    tree->nodes[i].height = -1;
+    tree->nodes[i].next = i + 1 < tree->capacity ? i + 1 : AABB_TREE_NULL;
+  }
+  tree->free_list = first;
+}
+
+AABBTree *aabb_tree_init(Scalar margin){
+  AABBTree *tree = malloc(sizeof(AABBTree));
+  assert(tree != NULL);
+  tree->margin = margin;
+  tree->root = AABB_TREE_NULL;
+  tree->capacity = AABB_TREE_INITIAL_NODES;
+  tree->nodes = malloc(tree->capacity * sizeof(AABBTreeNode));
+  assert(tree->nodes != NULL);
+  aabb_tree_free_nodes(tree, 0);
+  tree->size = 0;
+  return tree;
+}
+
+void aabb_tree_free(AABBTree *tree){
+  free(tree->nodes);
+  free(tree);
+}
+
+// Takes a node off the free list, doubling the nodes if there are none
+size_t aabb_tree_alloc_node(AABBTree *tree){
+  if(tree->free_list == AABB_TREE_NULL){
+    size_t old_capacity = tree->capacity;
+    tree->capacity *= 2;
+    tree->nodes = realloc(tree->nodes, tree->capacity * sizeof(AABBTreeNode));
+    assert(tree->nodes != NULL);
+    aabb_tree_free_nodes(tree, old_capacity);
+  }
+  size_t node = tree->free_list;
+  tree->free_list = tree->nodes[node].next;
+  tree->nodes[node].parent = AABB_TREE_NULL;
+  tree->nodes[node].child1 = AABB_TREE_NULL;
+  tree->nodes[node].child2 = AABB_TREE_NULL;
+  tree->nodes[node].height = 0;
+  return node;
+}
+
+// Returns a node to the free list
+void aabb_tree_release_node(AABBTree *tree, size_t node){
+  tree->nodes[node].height = -1;
+  tree->nodes[node].next = tree->free_list;
+  tree->free_list = node;
+}
+
+// Gets the smallest box around two boxes
+AABB aabb_union(AABB box1, AABB box2){
+  return (AABB){
+    {fmin(box1.min.x, box2.min.x), fmin(box1.min.y, box2.min.y)},
+    {fmax(box1.max.x, box2.max.x), fmax(box1.max.y, box2.max.y)}};
+}
+
+// Gets the perimeter of a box, which is how the tree measures the cost of
+// a node (larger boxes are overlapped by more queries)
+Scalar aabb_perimeter(AABB box){
+  return 2 * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+}
+
+// Returns whether inner lies entirely within outer
+bool aabb_contains(AABB outer, AABB inner){
+  return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y &&
+    inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+bool aabb_tree_is_leaf(AABBTree *tree, size_t node){
+  return tree->nodes[node].child1 == AABB_TREE_NULL;
+}
+
+// Recomputes an inner node's box and height from its children
+void aabb_tree_refit_node(AABBTree *tree, size_t node){
+  AABBTreeNode *nodes = tree->nodes;
+  size_t child1 = nodes[node].child1;
+  size_t child2 = nodes[node].child2;
+  nodes[node].box = aabb_union(nodes[child1].box, nodes[child2].box);
+  int height1 = nodes[child1].height;
+  int height2 = nodes[child2].height;
+  nodes[node].height = 1 + (height1 > height2 ? height1 : height2);
+}
+
+// Replaces a node's child, or the root if it has no parent
+void aabb_tree_replace_child(AABBTree *tree, size_t parent, size_t old_child, size_t new_child){
+  if(parent == AABB_TREE_NULL){
+    tree->root = new_child;
+  }
+  else if(tree->nodes[parent].child1 == old_child){
+    tree->nodes[parent].child1 = new_child;
+  }
+  else{
+    tree->nodes[parent].child2 = new_child;
+  }
+  tree->nodes[new_child].parent = parent;
+}
+
+// Lifts the taller child of a node's taller child above it if the node is
+// out of balance, as in an AVL tree. Returns the node now in its place.
+size_t aabb_tree_balance(AABBTree *tree, size_t node){
+  AABBTreeNode *nodes = tree->nodes;
+  if(aabb_tree_is_leaf(tree, node) || nodes[node].height < 2){
+    return node;
+  }
+  size_t child1 = nodes[node].child1;
+  size_t child2 = nodes[node].child2;
+  int balance = nodes[child2].height - nodes[child1].height;
+  if(balance >= -1 && balance <= 1){
+    return node;
+  }
+  // The taller child rises to take the node's place
+  size_t taller = balance > 1 ? child2 : child1;
+  size_t shorter = balance > 1 ? child1 : child2;
+  size_t grandchild1 = nodes[taller].child1;
+  size_t grandchild2 = nodes[taller].child2;
+  aabb_tree_replace_child(tree, nodes[node].parent, node, taller);
+  nodes[taller].child1 = node;
+  nodes[node].parent = taller;
+
+  // The node keeps the shorter grandchild; the taller one stays under taller
+  size_t kept = nodes[grandchild1].height > nodes[grandchild2].height ? grandchild2 : grandchild1;
+  size_t raised = kept == grandchild1 ? grandchild2 : grandchild1;
+  nodes[taller].child2 = raised;
+  nodes[raised].parent = taller;
+  nodes[node].child1 = shorter;
+  nodes[node].child2 = kept;
+  nodes[kept].parent = node;
+  aabb_tree_refit_node(tree, node);
+  aabb_tree_refit_node(tree, taller);
+  return taller;
+}
+
+// Refits and rebalances every node from a node up to the root
+void aabb_tree_fix_upwards(AABBTree *tree, size_t node){
+  while(node != AABB_TREE_NULL){
+    node = aabb_tree_balance(tree, node);
+    aabb_tree_refit_node(tree, node);
+    node = tree->nodes[node].parent;
+  }
+}
+
+// Picks the node to pair a new leaf with: descends from the root towards
+// whichever child grows the least by taking in the leaf's box
+size_t aabb_tree_pick_sibling(AABBTree *tree, AABB box){
+  AABBTreeNode *nodes = tree->nodes;
+  size_t node = tree->root;
+  while(!aabb_tree_is_leaf(tree, node)){
+    Scalar area = aabb_perimeter(nodes[node].box);
+    Scalar combined = aabb_perimeter(aabb_union(nodes[node].box, box));
+    // Pairing with this node makes a new parent of the combined size, and
+    // every ancestor grows by the difference
+    Scalar cost = 2 * combined;
+    Scalar inherited = 2 * (combined - area);
+    Scalar child_costs[2];
+    size_t children[2] = {nodes[node].child1, nodes[node].child2};
+    for(size_t i = 0; i < 2; i++){
+      AABB joined = aabb_union(nodes[children[i]].box, box);
+      child_costs[i] = aabb_perimeter(joined) + inherited;
+      if(!aabb_tree_is_leaf(tree, children[i])){
+        child_costs[i] -= aabb_perimeter(nodes[children[i]].box);
+      }
+    }
+    if(cost < child_costs[0] && cost < child_costs[1]){
+      break;
+    }
+    node = child_costs[0] <= child_costs[1] ? children[0] : children[1];
+  }
+  return node;
+}
+
+// Links a leaf into the tree next to the best sibling for it
+void aabb_tree_insert_leaf(AABBTree *tree, size_t leaf){
+  if(tree->root == AABB_TREE_NULL){
+    tree->root = leaf;
+    tree->nodes[leaf].parent = AABB_TREE_NULL;
+    return;
+  }
+  size_t sibling = aabb_tree_pick_sibling(tree, tree->nodes[leaf].box);
+  size_t old_parent = tree->nodes[sibling].parent;
+  size_t parent = aabb_tree_alloc_node(tree);
+  aabb_tree_replace_child(tree, old_parent, sibling, parent);
+  tree->nodes[parent].child1 = sibling;
+  tree->nodes[parent].child2 = leaf;
+  tree->nodes[sibling].parent = parent;
+  tree->nodes[leaf].parent = parent;
+  aabb_tree_fix_upwards(tree, parent);
+}
+
+// Unlinks a leaf from the tree, freeing its parent, which the leaf's sibling
+// replaces
+void aabb_tree_remove_leaf(AABBTree *tree, size_t leaf){
+  size_t parent = tree->nodes[leaf].parent;
+  if(parent == AABB_TREE_NULL){
+    tree->root = AABB_TREE_NULL;
+    return;
+  }
+  size_t sibling = tree->nodes[parent].child1 == leaf
+    ? tree->nodes[parent].child2 : tree->nodes[parent].child1;
+  size_t grandparent = tree->nodes[parent].parent;
+  aabb_tree_replace_child(tree, grandparent, parent, sibling);
+  aabb_tree_release_node(tree, parent);
+  aabb_tree_fix_upwards(tree, grandparent);
+}
+
+// Grows a box by the tree's margin on every side
+AABB aabb_tree_fatten(AABBTree *tree, AABB box){
+  Vector margin = {tree->margin, tree->margin};
+  return (AABB){vec_subtract(box.min, margin), vec_add(box.max, margin)};
+}
+
+size_t aabb_tree_insert(AABBTree *tree, AABB box, size_t id){
+  size_t leaf = aabb_tree_alloc_node(tree);
+  tree->nodes[leaf].box = aabb_tree_fatten(tree, box);
+  tree->nodes[leaf].id = id;
+  aabb_tree_insert_leaf(tree, leaf);
+  tree->size++;
+  return leaf;
+}
+
+void aabb_tree_remove(AABBTree *tree, size_t proxy){
+  assert(proxy < tree->capacity && aabb_tree_is_leaf(tree, proxy) && tree->nodes[proxy].height == 0);
+  aabb_tree_remove_leaf(tree, proxy);
+  aabb_tree_release_node(tree, proxy);
+  tree->size--;
+}
+
+bool aabb_tree_move(AABBTree *tree, size_t proxy, AABB box){
+  if(aabb_contains(tree->nodes[proxy].box, box)){
+    return false;
+  }
+  aabb_tree_remove_leaf(tree, proxy);
+  tree->nodes[proxy].box = aabb_tree_fatten(tree, box);
+  aabb_tree_insert_leaf(tree, proxy);
+  return true;
+}
+
+size_t aabb_tree_get_id(AABBTree *tree, size_t proxy){
+  return tree->nodes[proxy].id;
+}
+
+AABB aabb_tree_get_fat_box(AABBTree *tree, size_t proxy){
+  return tree->nodes[proxy].box;
+}
+
+size_t aabb_tree_size(AABBTree *tree){
+  return tree->size;
+}
+
+size_t aabb_tree_height(AABBTree *tree){
+  return tree->root == AABB_TREE_NULL ? 0 : (size_t) tree->nodes[tree->root].height + 1;
+}
+
+// Reports the leaves under a node that overlap a box
+void aabb_tree_query_node(AABBTree *tree, size_t node, AABB box,
+  AABBTreeQueryHandler handler, void *aux){
+  if(!aabb_overlap(tree->nodes[node].box, box)){
+    return;
+  }
+  if(aabb_tree_is_leaf(tree, node)){
+    handler(tree->nodes[node].id, aux);
+    return;
+  }
+  aabb_tree_query_node(tree, tree->nodes[node].child1, box, handler, aux);
+  aabb_tree_query_node(tree, tree->nodes[node].child2, box, handler, aux);
+}
+
+void aabb_tree_query(AABBTree *tree, AABB box, AABBTreeQueryHandler handler, void *aux){
+  if(tree->root != AABB_TREE_NULL){
+    aabb_tree_query_node(tree, tree->root, box, handler, aux);
+  }
+}
+
+// Reports the overlapping pairs of a leaf under node1 in tree1 and a leaf
+// under node2 in tree2, descending into the larger node first
+void aabb_tree_cross(AABBTree *tree1, size_t node1, AABBTree *tree2, size_t node2,
+  AABBTreePairHandler handler, void *aux){
+  AABBTreeNode *first = &tree1->nodes[node1];
+  AABBTreeNode *second = &tree2->nodes[node2];
+  if(!aabb_overlap(first->box, second->box)){
+    return;
+  }
+  bool leaf1 = aabb_tree_is_leaf(tree1, node1);
+  bool leaf2 = aabb_tree_is_leaf(tree2, node2);
+  if(leaf1 && leaf2){
+    handler(first->id, second->id, aux);
+  }
+  else if(leaf2 || (!leaf1 && aabb_perimeter(first->box) >= aabb_perimeter(second->box))){
+    aabb_tree_cross(tree1, first->child1, tree2, node2, handler, aux);
+    aabb_tree_cross(tree1, first->child2, tree2, node2, handler, aux);
+  }
+  else{
+    aabb_tree_cross(tree1, node1, tree2, second->child1, handler, aux);
+    aabb_tree_cross(tree1, node1, tree2, second->child2, handler, aux);
+  }
+}
+
+// Reports the overlapping pairs of leaves under a node: those within each
+// child, then those across the two
+void aabb_tree_self_cross(AABBTree *tree, size_t node, AABBTreePairHandler handler, void *aux){
+  if(aabb_tree_is_leaf(tree, node)){
+    return;
+  }
+  size_t child1 = tree->nodes[node].child1;
+  size_t child2 = tree->nodes[node].child2;
+  aabb_tree_self_cross(tree, child1, handler, aux);
+  aabb_tree_self_cross(tree, child2, handler, aux);
+  aabb_tree_cross(tree, child1, tree, child2, handler, aux);
+}
+
+void aabb_tree_find_pairs(AABBTree *tree, AABBTreePairHandler handler, void *aux){
+  if(tree->root != AABB_TREE_NULL){
+    aabb_tree_self_cross(tree, tree->root, handler, aux);
+  }
+}
+
+void aabb_tree_find_pairs_between(AABBTree *tree1, AABBTree *tree2,
+  AABBTreePairHandler handler, void *aux){
+  if(tree1->root != AABB_TREE_NULL && tree2->root != AABB_TREE_NULL){
+    aabb_tree_cross(tree1, tree1->root, tree2, tree2->root, handler, aux);
+  }
+}
@@ -0,0 +1,116 @@
+#include "arena.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// Every allocation is aligned to a multiple of this
+const size_t ARENA_ALIGNMENT = 16;
+// The number of bytes in the first chunk of the frame arena
+const size_t FRAME_ARENA_CAPACITY = 16384;
+
+// Starts each chunk; the memory handed out follows it
+typedef struct arena_chunk {
+  struct arena_chunk *next;
+  size_t capacity;
+  size_t used;
+} ArenaChunk;
+
+struct arena {
+  // The chunks in the order they are filled; they are never freed before the arena
+  ArenaChunk *first;
+  ArenaChunk *current;
+  size_t capacity;
+};
+
+/**
+ * The arena for temporaries that only live for the current frame.
+ */
+Arena *frame_arena_instance = NULL;
+
+// Rounds size up to a multiple of ARENA_ALIGNMENT
+size_t arena_round_up(size_t size) {
+  return (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+}
+
+// Allocates an empty chunk that can hold capacity bytes
+ArenaChunk *arena_chunk_init(size_t capacity) {
+  ArenaChunk *chunk = malloc(arena_round_up(sizeof(ArenaChunk)) + capacity);
+  assert(chunk != NULL);
+  chunk->next = NULL;
+  chunk->capacity = capacity;
+  chunk->used = 0;
+  return chunk;
+}
+
+Arena *arena_init(size_t capacity) {
+  Arena *arena = malloc(sizeof(Arena));
+  assert(arena != NULL);
+  capacity = arena_round_up(capacity > 0 ? capacity : 1);
+  arena->first = arena_chunk_init(capacity);
+  arena->current = arena->first;
+  arena->capacity = capacity;
+  return arena;
+}
+
+void arena_free(Arena *arena) {
+  ArenaChunk *chunk = arena->first;
+  while(chunk != NULL) {
+    ArenaChunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  free(arena);
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  size = arena_round_up(size);
+  ArenaChunk *chunk = arena->current;
+  // Moves on to the next chunk that fits, reusing chunks kept from earlier frames
+  while(chunk->used + size > chunk->capacity) {
+    if(chunk->next == NULL || chunk->next->capacity < size) {
+      // Each new chunk at least doubles the capacity of the arena
+      size_t capacity = arena->capacity > size ? arena->capacity : size;
+      ArenaChunk *added = arena_chunk_init(capacity);
+      added->next = chunk->next;
+      chunk->next = added;
+      arena->capacity += capacity;
+    }
+    chunk = chunk->next;
+    chunk->used = 0;
+  }
+  arena->current = chunk;
+  void *memory = (char *) chunk + arena_round_up(sizeof(ArenaChunk)) + chunk->used;
+  chunk->used += size;
+  return memory;
+}
+
+ArenaMark arena_mark(Arena *arena) {
+  return (ArenaMark){arena->current, arena->current->used};
+}
+
+void arena_rewind(Arena *arena, ArenaMark mark) {
+  arena->current = mark.chunk;
+  arena->current->used = mark.used;
+}
+
+void arena_reset(Arena *arena) {
+  arena_rewind(arena, (ArenaMark){arena->first, 0});
+}
+
+size_t arena_capacity(Arena *arena) {
+  return arena->capacity;
+}
+
+Arena *frame_arena(void) {
+  if(frame_arena_instance == NULL) {
+    frame_arena_instance = arena_init(FRAME_ARENA_CAPACITY);
+  }
+  return frame_arena_instance;
+}
+
+void *frame_alloc(size_t size) {
+  return arena_alloc(frame_arena(), size);
+}
+
+void frame_reset(void) {
+  arena_reset(frame_arena());
+}
@@ -4,33 +4,106 @@
 #include "assert.h"
 #include <math.h>
 #include "shape.h"
+#include "pool.h"
+#include "simd.h"
 
 const int DEBUG_B = 0;
 // 0 is false 1 is true. When true, all assert statements and print statements
 // run. Used to handle the epic random crash problem.
 
-Body *body_init(List *shape, double mass, RGBColor color, double radius){
-    Body *thisBod = malloc(sizeof(Body));
-    assert(thisBod != NULL);
-    thisBod->points = shape;
-    thisBod->m = mass;
-    thisBod->c = color;
-    thisBod->vel = VEC_ZERO;
-    thisBod->theta = 0.0;
-    thisBod->force = VEC_ZERO;
-    thisBod->impulse = VEC_ZERO;
-    thisBod->info = NULL;
-    thisBod->info_freer = NULL;
-    thisBod->removed = false;
-    thisBod->radius = radius;
-    return thisBod;
+// Generation 0 is never given to a slot, so this handle never resolves
+const BodyHandle BODY_HANDLE_NONE = {
+  .index = 0,
+  .generation = 0
+};
+
+// Marks the end of the free slot chain
+const size_t NO_FREE_SLOT = (size_t) -1;
+const size_t BODY_NO_CATEGORY = (size_t) -1;
+// Counts contacts up to 60 degrees either side of straight down
+const Scalar BODY_GROUNDED_MIN_SLOPE = 0.5;
+
+/**
+ * A slot in the body registry. The removed flag mirrors the body's own, so
+ * liveness can be checked without touching the body. Freed slots are chained
+ * together through next_free and reused with a new generation.
+ */
+typedef struct body_slot {
+  Body *body;
+  size_t generation;
+  bool removed;
+  size_t next_free;
+} BodySlot;
+
+/**
+ * The body registry, indexed by BodyHandle.index.
+ */
+BodySlot *body_slots = NULL;
+size_t body_slots_size = 0;
+size_t body_slots_capacity = 0;
+/**
+ * The index of the first free slot, or NO_FREE_SLOT if every slot is in use.
+ */
+size_t body_slots_free = NO_FREE_SLOT;
+
+// Gives a body a slot in the registry, reusing a freed slot if there is one
+BodyHandle body_slot_acquire(Body *body){
+  size_t index;
+  if(body_slots_free != NO_FREE_SLOT){
+    index = body_slots_free;
+    body_slots_free = body_slots[index].next_free;
+  }
+  else {
+    if(body_slots_size == body_slots_capacity){
+      body_slots_capacity = body_slots_capacity == 0 ? 64 : body_slots_capacity * 2;
+      body_slots = realloc(body_slots, body_slots_capacity * sizeof(BodySlot));
+      assert(body_slots != NULL);
+    }
+    index = body_slots_size;
+    body_slots_size++;
+    body_slots[index].generation = 1;
+  }
+  body_slots[index].body = body;
+  body_slots[index].removed = false;
+  body_slots[index].next_free = NO_FREE_SLOT;
+  return (BodyHandle){index, body_slots[index].generation};
 }
 
-Body *body_init_with_info(
-    List *shape, double mass, RGBColor color, void *info, FreeFunc info_freer, double radius){
-    Body *thisBod = malloc(sizeof(Body));
-    assert(thisBod != NULL);
-    thisBod->points = shape;
+// Invalidates every outstanding handle to the freed body in the given slot
+// and returns the slot to the free chain
+void body_slot_release(size_t index){
+  body_slots[index].generation++;
+  body_slots[index].body = NULL;
+  body_slots[index].next_free = body_slots_free;
+  body_slots_free = index;
+}
+
+/**
+ * The pool every Body is allocated from, created on first use.
+ */
+Pool *body_pool = NULL;
+// The number of bodies the pool allocates space for at a time
+const size_t BODY_POOL_BLOCK = 64;
+
+// Takes ownership of a shape given in world coordinates as the body's local
+// shape, by moving it to be relative to its centroid and undoing the body's
+// rotation, so that body_get_transform() places it back where it was
+void body_localize_shape(Body *body, Polygon *shape){
+    body->centroid = polygon_centroid(shape);
+    polygon_transform(shape, transform_invert(body_get_transform(body)));
+    body->prototype = shape_prototype_init(shape);
+    body->axes_dirty = true;
+    body->world_dirty = true;
+    body->collision_dirty = true;
+    body->bounds_dirty = true;
+}
+
+// Allocates a body at rest with everything but its shape set
+Body *body_alloc(Scalar mass, RGBColor color, void *info, FreeFunc info_freer, Scalar radius){
+    if(body_pool == NULL){
+      body_pool = pool_init("Body", sizeof(Body), BODY_POOL_BLOCK);
+    }
+    Body *thisBod = pool_alloc(body_pool);
     thisBod->m = mass;
     thisBod->c = color;
     thisBod->vel = VEC_ZERO;
@@ -41,24 +114,129 @@ Body *body_init_with_info(
     thisBod->info_freer = info_freer;
     thisBod->removed = false;
     thisBod->radius = radius;
+    thisBod->collision_points = NULL;
+    thisBod->axes = NULL;
+    thisBod->axes_capacity = 0;
+    thisBod->axes_dirty = true;
+    thisBod->circle = false;
+    thisBod->category = BODY_NO_CATEGORY;
+    thisBod->contacts = NULL;
+    thisBod->contact_count = 0;
+    thisBod->contact_capacity = 0;
+    thisBod->handle = body_slot_acquire(thisBod);
+    return thisBod;
+}
+
+Body *body_init(Polygon *shape, Scalar mass, RGBColor color, Scalar radius){
+    return body_init_with_info(shape, mass, color, NULL, NULL, radius);
+}
+
+Body *body_init_with_info(
+    Polygon *shape, Scalar mass, RGBColor color, void *info, FreeFunc info_freer, Scalar radius){
+    Body *thisBod = body_alloc(mass, color, info, info_freer, radius);
+    thisBod->points = polygon_init(polygon_size(shape));
+    body_localize_shape(thisBod, shape);
+    return thisBod;
+}
+
+Body *body_init_with_prototype(
+    ShapePrototype *prototype, Vector position, Scalar mass, RGBColor color,
+    void *info, FreeFunc info_freer, Scalar radius){
+    Body *thisBod = body_alloc(mass, color, info, info_freer, radius);
+    Polygon *local = shape_prototype_get_polygon(prototype);
+    thisBod->points = polygon_init(polygon_size(local));
+    thisBod->prototype = prototype;
+    thisBod->centroid = vec_add(position, shape_prototype_get_offset(prototype));
+    thisBod->world_dirty = true;
+    thisBod->collision_dirty = true;
+    thisBod->bounds_dirty = true;
     return thisBod;
 }
 
 
 void body_free(Body *body){
+    body_slot_release(body->handle.index);
     if(body->info_freer != NULL){
       body->info_freer(body->info);
     }
-    list_free(body->points);
-    free(body);
+    shape_prototype_release(body->prototype);
+    polygon_free(body->points);
+    if(body->collision_points != NULL){
+      polygon_free(body->collision_points);
+    }
+    free(body->axes);
+    free(body->contacts);
+    pool_release(body_pool, body);
 }
 
-List *body_get_shape(Body *body){
+Transform2D body_get_transform(Body *body){
+    return transform_compose(transform_translation(body->centroid),
+      transform_rotation(body->theta, VEC_ZERO));
+}
+
+Polygon *body_get_shape(Body *body){
+    if(body->world_dirty){
+      polygon_copy_transformed(body->points,
+        shape_prototype_get_polygon(body->prototype), body_get_transform(body));
+      body->world_dirty = false;
+    }
     return body->points;
 }
 
+Polygon *body_get_collision_shape(Body *body){
+    Polygon *local = shape_prototype_get_collision_lod(body->prototype);
+    if(local == shape_prototype_get_polygon(body->prototype)){
+      return body_get_shape(body);
+    }
+    if(body->collision_points == NULL){
+      body->collision_points = polygon_init(polygon_size(local));
+    }
+    if(body->collision_dirty){
+      polygon_copy_transformed(body->collision_points, local, body_get_transform(body));
+      body->collision_dirty = false;
+    }
+    return body->collision_points;
+}
+
+Vector *body_get_axes(Body *body, size_t *count){
+    Vector *local = shape_prototype_get_axes(body->prototype, count);
+    if(body->theta == 0){
+      return local;
+    }
+    if(body->axes_dirty){
+      if(body->axes_capacity < *count){
+        body->axes_capacity = *count;
+        body->axes = realloc(body->axes, body->axes_capacity * sizeof(Vector));
+        assert(body->axes != NULL);
+      }
+      // Rotating the normals keeps them unit length, so none are recomputed
+      Transform2D rotation = transform_rotation(body->theta, VEC_ZERO);
+      simd_transform(local, body->axes, *count, rotation.cos_angle, rotation.sin_angle, VEC_ZERO);
+      body->axes_dirty = false;
+    }
+    return body->axes;
+}
+
 Vector body_get_centroid(Body *body){
-    return polygon_centroid(body->points);
+    return body->centroid;
+}
+
+Scalar body_get_area(Body *body){
+    return shape_prototype_get_area(body->prototype);
+}
+
+AABB body_get_bounds(Body *body){
+    if(body->bounds_dirty){
+      if(body->theta == 0){
+        body->local_bounds = shape_prototype_get_bounds(body->prototype);
+      }
+      else{
+        body->local_bounds = aabb_translate(polygon_bounds(body_get_shape(body)),
+          vec_negate(body->centroid));
+      }
+      body->bounds_dirty = false;
+    }
+    return aabb_translate(body->local_bounds, body->centroid);
 }
 
 Vector body_get_velocity(Body *body){
@@ -73,7 +251,7 @@ RGBColor body_get_color(Body *body){
     return body->c;
 }
 
-double body_get_mass(Body *body){
+Scalar body_get_mass(Body *body){
   return body->m;
 }
 
@@ -84,6 +262,7 @@ void *body_get_info(Body *body){
 void body_remove(Body *body){
   if(!body->removed){
     body->removed = true;
+    body_slots[body->handle.index].removed = true;
   }
 }
 
@@ -91,6 +270,34 @@ bool body_is_removed(Body *body){
   return body->removed;
 }
 
+BodyHandle body_get_handle(Body *body){
+  if(body == NULL){
+    return BODY_HANDLE_NONE;
+  }
+  return body->handle;
+}
+
+// Returns whether a handle still refers to a body that has not been freed
+bool body_handle_is_current(BodyHandle handle){
+  return handle.index < body_slots_size &&
+    body_slots[handle.index].generation == handle.generation;
+}
+
+bool body_handle_equal(BodyHandle handle1, BodyHandle handle2){
+  return handle1.index == handle2.index && handle1.generation == handle2.generation;
+}
+
+bool body_handle_is_live(BodyHandle handle){
+  return body_handle_is_current(handle) && !body_slots[handle.index].removed;
+}
+
+Body *body_from_handle(BodyHandle handle){
+  if(!body_handle_is_current(handle)){
+    return NULL;
+  }
+  return body_slots[handle.index].body;
+}
+
 /*Extra functionality*/
 Vector body_get_force(Body *body){
     return body->force;
@@ -100,38 +307,121 @@ Vector body_get_impulse(Body *body){
     return body->impulse;
 }
 
-double body_get_radius(Body *body){
+Scalar body_get_radius(Body *body){
   return body->radius;
 }
 
 /*Set functions*/
-void body_set_shape(Body *body, List* new_shape) {
-  List* old = body->points;
-  body->points = new_shape;
-  list_free(old);
+void body_set_shape(Body *body, Polygon* new_shape) {
+  shape_prototype_release(body->prototype);
+  body_localize_shape(body, new_shape);
+}
+
+void body_set_circle(Body *body, bool circle){
+  body->circle = circle;
+}
+
+bool body_is_circle(Body *body){
+  return body->circle;
+}
+
+void body_set_category(Body *body, size_t category){
+  body->category = category;
+}
+
+size_t body_get_category(Body *body){
+  return body->category;
+}
+
+Contact *body_get_contacts(Body *body, size_t *count){
+  *count = body->contact_count;
+  return body->contacts;
+}
+
+bool body_is_grounded(Body *body){
+  for(size_t i = 0; i < body->contact_count; i++){
+    if(body->contacts[i].normal.y <= -BODY_GROUNDED_MIN_SLOPE){
+      return true;
+    }
+  }
+  return false;
+}
+
+void body_set_contact(Body *body, BodyHandle other, Vector normal){
+  for(size_t i = 0; i < body->contact_count; i++){
+    if(body_handle_equal(body->contacts[i].other, other)){
+      body->contacts[i] = (Contact){other, normal};
+      return;
+    }
+  }
+  if(body->contact_count == body->contact_capacity){
+    body->contact_capacity = body->contact_capacity == 0 ? 4 : 2 * body->contact_capacity;
+    body->contacts = realloc(body->contacts, body->contact_capacity * sizeof(Contact));
+    assert(body->contacts != NULL);
+  }
+  body->contacts[body->contact_count] = (Contact){other, normal};
+  body->contact_count++;
+}
+
+void body_clear_contact(Body *body, BodyHandle other){
+  for(size_t i = 0; i < body->contact_count; i++){
+    if(body_handle_equal(body->contacts[i].other, other)){
+      // Contacts are unordered, so the last one fills the hole
+      body->contact_count--;
+      body->contacts[i] = body->contacts[body->contact_count];
+      return;
+    }
+  }
+}
+
+bool body_is_box(Body *body){
+  return body->theta == 0 && shape_prototype_is_box(body->prototype);
+}
+
+ShapePrototype *body_get_prototype(Body *body){
+  return body->prototype;
+}
+
+void body_set_prototype(Body *body, ShapePrototype *prototype){
+  // Redrawing a star at the same size every tick leaves nothing to rebuild
+  shape_prototype_release(body->prototype);
+  if(prototype == body->prototype){
+    return;
+  }
+  body->prototype = prototype;
+  body->axes_dirty = true;
+  body->world_dirty = true;
+  body->collision_dirty = true;
+  body->bounds_dirty = true;
 }
 
 // Only used for objects that have a radius or a y-height
-void body_set_radius(Body* body, double new_r){
+void body_set_radius(Body* body, Scalar new_r){
   body->radius = new_r;
 }
 
-void body_set_mass(Body* body, double mass){
+void body_set_mass(Body* body, Scalar mass){
   body->m = mass;
 }
 
 void body_set_centroid(Body *body, Vector x){
-    polygon_translate(body->points, vec_negate(body_get_centroid(body)));
-    polygon_translate(body->points, x);
+    // The vertices are only moved once they are asked for
+    body->centroid = x;
+    body->world_dirty = true;
+    body->collision_dirty = true;
 }
 
 void body_set_velocity(Body *body, Vector v){
     body->vel = v;
 }
 
-void body_set_rotation(Body *body, double angle){
-    polygon_rotate(body->points, angle - body->theta, body_get_centroid(body));
+void body_set_rotation(Body *body, Scalar angle){
+    // Rotating about the centroid keeps it and the area, but not the bounds
     body->theta = angle;
+    body->axes_dirty = true;
+    body->world_dirty = true;
+    body->collision_dirty = true;
+    body->bounds_dirty = true;
 }
 
 void body_set_force(Body *body, Vector force){
@@ -144,17 +434,13 @@ void body_set_impulse(Body *body, Vector impulse){
 
 void body_star_set_num_sides(Body *body, int sides)
 {
-  List* old = body->points;
-  body->points = create_star(sides, body_get_centroid(body), body_get_radius(body));
-  list_free(old);
+  body_set_prototype(body, shape_prototype_star(sides, body_get_radius(body)));
 }
 
-void body_star_set_radius_draw(Body *body, double radius, int sides)
+void body_star_set_radius_draw(Body *body, Scalar radius, int sides)
 {
-  List* old = body->points;
   body->radius = radius;
-  body->points = create_star(sides, body_get_centroid(body), radius);
-  list_free(old);
+  body_set_prototype(body, shape_prototype_star(sides, radius));
 }
 
 void body_add_force(Body *body, Vector force){
@@ -165,7 +451,7 @@ void body_add_impulse(Body *body, Vector impulse){
   body_set_impulse(body, vec_add(body_get_impulse(body), impulse));
 }
 
-void body_tick(Body *body, double dt){
+void body_tick(Body *body, Scalar dt){
   Vector vel_before = body_get_velocity(body);
   Vector total_impulse = vec_add(body_get_impulse(body), vec_multiply(dt, body_get_force(body)));
   if(DEBUG_B)
@@ -207,7 +493,7 @@ void body_tick(Body *body, double dt){
 }
 
 /* All extra functionality */
-void body_accelerate(Body * body, Vector a, double dt)
+void body_accelerate(Body * body, Vector a, Scalar dt)
 {
   body_set_velocity(body, vec_add(body_get_velocity(body), (vec_multiply(dt, a))));
 }
@@ -0,0 +1,453 @@
+#include "broad_phase.h"
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+const Scalar BROAD_PHASE_DEFAULT_CELL_SIZE = 25;
+// The most cells a box may cover before it is checked against every box
+const Scalar BROAD_PHASE_MAX_CELLS = 64;
+// The number of entries the grid allocates space for at first
+const size_t BROAD_PHASE_INITIAL_ENTRIES = 64;
+
+// One box placed in one cell of the grid
+typedef struct grid_entry {
+  uint64_t cell;
+  size_t id;
+} GridEntry;
+
+// What a broad phase keeps for one key from one call to the next
+typedef struct broad_phase_key {
+  // The id of the box given with this key on the last call it was given on
+  size_t id;
+  // The call the key was last given on, 0 if never
+  size_t call;
+  // Whether the key is in the sorted orders or in the tree
+  bool listed;
+  // The key's proxy in the tree, if it is in the tree
+  size_t proxy;
+} BroadPhaseKey;
+
+struct broad_phase {
+  BroadPhaseKind kind;
+  Scalar cell_size;
+  // The entries of the grid, rebuilt on every call but kept to reuse the memory
+  GridEntry *entries;
+  size_t entry_capacity;
+  // The ids of the boxes too large for the grid, and which boxes those are,
+  // likewise
+  size_t *oversized;
+  bool *is_oversized;
+  size_t oversized_capacity;
+  // What is kept for each key between calls, indexed by key
+  BroadPhaseKey *keys;
+  size_t key_capacity;
+  // The number of calls so far, to tell which keys were given on this one
+  size_t call;
+  // The keys of the boxes as sorted on each axis by the last sweep; keys that
+  // are new or gone are added or dropped before sorting again
+  size_t *order[2];
+  size_t order_size;
+  size_t order_capacity;
+  // The tree of boxes, which holds them by key, and the keys in it
+  AABBTree *tree;
+  size_t *tree_keys;
+  size_t tree_size;
+  size_t tree_capacity;
+  BroadPhaseStats stats;
+};
+
+BroadPhase *broad_phase_init(BroadPhaseKind kind){
+  BroadPhase *broad_phase = malloc(sizeof(BroadPhase));
+  assert(broad_phase != NULL);
+  broad_phase->kind = kind;
+  broad_phase->cell_size = BROAD_PHASE_DEFAULT_CELL_SIZE;
+  broad_phase->entries = NULL;
+  broad_phase->entry_capacity = 0;
+  broad_phase->oversized = NULL;
+  broad_phase->is_oversized = NULL;
+  broad_phase->oversized_capacity = 0;
+  broad_phase->keys = NULL;
+  broad_phase->key_capacity = 0;
+  broad_phase->call = 0;
+  broad_phase->order[0] = NULL;
+  broad_phase->order[1] = NULL;
+  broad_phase->order_size = 0;
+  broad_phase->order_capacity = 0;
+  broad_phase->tree = kind == BROAD_PHASE_TREE ? aabb_tree_init(AABB_TREE_DEFAULT_MARGIN) : NULL;
+  broad_phase->tree_keys = NULL;
+  broad_phase->tree_size = 0;
+  broad_phase->tree_capacity = 0;
+  broad_phase->stats = (BroadPhaseStats){0, 0, 0, 0};
+  return broad_phase;
+}
+
+void broad_phase_free(BroadPhase *broad_phase){
+  free(broad_phase->entries);
+  free(broad_phase->oversized);
+  free(broad_phase->is_oversized);
+  free(broad_phase->keys);
+  free(broad_phase->order[0]);
+  free(broad_phase->order[1]);
+  if(broad_phase->tree != NULL){
+    aabb_tree_free(broad_phase->tree);
+  }
+  free(broad_phase->tree_keys);
+  free(broad_phase);
+}
+
+BroadPhaseKind broad_phase_get_kind(BroadPhase *broad_phase){
+  return broad_phase->kind;
+}
+
+void broad_phase_set_cell_size(BroadPhase *broad_phase, Scalar cell_size){
+  assert(cell_size > 0);
+  broad_phase->cell_size = cell_size;
+}
+
+Scalar broad_phase_get_cell_size(BroadPhase *broad_phase){
+  return broad_phase->cell_size;
+}
+
+BroadPhaseStats broad_phase_get_stats(BroadPhase *broad_phase){
+  return broad_phase->stats;
+}
+
+// Compares two boxes, reporting them to the handler if they overlap
+void broad_phase_test(BroadPhase *broad_phase, AABB *boxes, size_t id1, size_t id2,
+  BroadPhasePairHandler handler, void *aux){
+  broad_phase->stats.tests++;
+  if(aabb_overlap(boxes[id1], boxes[id2])){
+    handler(id1 < id2 ? id1 : id2, id1 < id2 ? id2 : id1, aux);
+    broad_phase->stats.pairs++;
+  }
+}
+
+// Checks every pair of boxes
+void broad_phase_all_pairs(BroadPhase *broad_phase, AABB *boxes, size_t count,
+  BroadPhasePairHandler handler, void *aux){
+  for(size_t i = 0; i < count; i++){
+    for(size_t j = i + 1; j < count; j++){
+      broad_phase_test(broad_phase, boxes, i, j, handler, aux);
+    }
+  }
+}
+
+// Packs the column and row of a cell into one key
+uint64_t grid_key(int32_t column, int32_t row){
+  return ((uint64_t) (uint32_t) column << 32) | (uint32_t) row;
+}
+
+// Gets the column or row of the cells containing a coordinate
+int32_t grid_index(BroadPhase *broad_phase, Scalar coordinate){
+  return (int32_t) floor(coordinate / broad_phase->cell_size);
+}
+
+// Orders grid entries by cell, then by id
+int grid_entry_compare(const void *a, const void *b){
+  const GridEntry *entry1 = a;
+  const GridEntry *entry2 = b;
+  if(entry1->cell != entry2->cell){
+    return entry1->cell < entry2->cell ? -1 : 1;
+  }
+  return (entry1->id > entry2->id) - (entry1->id < entry2->id);
+}
+
+// Adds a box to a cell of the grid, growing the entries if needed
+void grid_add(BroadPhase *broad_phase, size_t *size, uint64_t cell, size_t id){
+  if(*size == broad_phase->entry_capacity){
+    broad_phase->entry_capacity = broad_phase->entry_capacity == 0
+      ? BROAD_PHASE_INITIAL_ENTRIES : broad_phase->entry_capacity * 2;
+    broad_phase->entries = realloc(broad_phase->entries,
+      broad_phase->entry_capacity * sizeof(GridEntry));
+    assert(broad_phase->entries != NULL);
+  }
+  broad_phase->entries[*size] = (GridEntry){cell, id};
+  (*size)++;
+}
+
+// Sorts the boxes into the cells they cover and checks the boxes that share
+// each cell. A pair sharing several cells is only reported from the one that
+// holds the lower left corner of their overlap.
+void broad_phase_grid_pairs(BroadPhase *broad_phase, AABB *boxes, size_t count,
+  BroadPhasePairHandler handler, void *aux){
+  Scalar cell_size = broad_phase->cell_size;
+  if(broad_phase->oversized_capacity < count){
+    broad_phase->oversized_capacity = count;
+    broad_phase->oversized = realloc(broad_phase->oversized, count * sizeof(size_t));
+    broad_phase->is_oversized = realloc(broad_phase->is_oversized, count * sizeof(bool));
+    assert(broad_phase->oversized != NULL && broad_phase->is_oversized != NULL);
+  }
+  size_t entries = 0;
+  size_t oversized = 0;
+  for(size_t i = 0; i < count; i++){
+    Scalar columns = floor(boxes[i].max.x / cell_size) - floor(boxes[i].min.x / cell_size) + 1;
+    Scalar rows = floor(boxes[i].max.y / cell_size) - floor(boxes[i].min.y / cell_size) + 1;
+    // Also catches boxes that are infinite or NaN
+    broad_phase->is_oversized[i] = !(columns * rows <= BROAD_PHASE_MAX_CELLS);
+    if(broad_phase->is_oversized[i]){
+      broad_phase->oversized[oversized] = i;
+      oversized++;
+      continue;
+    }
+    int32_t first_column = grid_index(broad_phase, boxes[i].min.x);
+    int32_t first_row = grid_index(broad_phase, boxes[i].min.y);
+    for(int32_t column = 0; column < (int32_t) columns; column++){
+      for(int32_t row = 0; row < (int32_t) rows; row++){
+        grid_add(broad_phase, &entries, grid_key(first_column + column, first_row + row), i);
+      }
+    }
+  }
+  // With no entries there is nothing to sort, and entries may still be NULL
+  if(entries > 0){
+    qsort(broad_phase->entries, entries, sizeof(GridEntry), grid_entry_compare);
+
+    GridEntry *grid = broad_phase->entries;
+    for(size_t start = 0; start < entries;){
+      size_t end = start + 1;
+      while(end < entries && grid[end].cell == grid[start].cell){
+        end++;
+      }
+      for(size_t i = start; i < end; i++){
+        for(size_t j = i + 1; j < end; j++){
+          AABB box1 = boxes[grid[i].id];
+          AABB box2 = boxes[grid[j].id];
+          int32_t column = grid_index(broad_phase, fmax(box1.min.x, box2.min.x));
+          int32_t row = grid_index(broad_phase, fmax(box1.min.y, box2.min.y));
+          if(grid_key(column, row) == grid[start].cell){
+            broad_phase_test(broad_phase, boxes, grid[i].id, grid[j].id, handler, aux);
+          }
+        }
+      }
+      start = end;
+    }
+  }
+
+  // Boxes too large for the grid are checked against every other box, and
+  // a pair of them only from the first
+  for(size_t k = 0; k < oversized; k++){
+    size_t i = broad_phase->oversized[k];
+    for(size_t j = 0; j < count; j++){
+      if(j != i && !(broad_phase->is_oversized[j] && j < i)){
+        broad_phase_test(broad_phase, boxes, i, j, handler, aux);
+      }
+    }
+  }
+}
+
+// Gets the lower edge of a box on an axis, x for 0 and y for 1
+Scalar sweep_min(AABB box, size_t axis){
+  return axis == 0 ? box.min.x : box.min.y;
+}
+
+// Gets the upper edge of a box on an axis, likewise
+Scalar sweep_max(AABB box, size_t axis){
+  return axis == 0 ? box.max.x : box.max.y;
+}
+
+// Gets the key of the box with an id, which is the id itself without keys
+size_t broad_phase_key_of(size_t *keys, size_t id){
+  return keys == NULL ? id : keys[id];
+}
+
+// Records which keys are given on this call and the ids of their boxes
+void broad_phase_sync_keys(BroadPhase *broad_phase, size_t *keys, size_t count){
+  broad_phase->call++;
+  for(size_t id = 0; id < count; id++){
+    size_t key = broad_phase_key_of(keys, id);
+    if(key >= broad_phase->key_capacity){
+      size_t capacity = broad_phase->key_capacity == 0 ? BROAD_PHASE_INITIAL_ENTRIES
+        : broad_phase->key_capacity;
+      while(capacity <= key){
+        capacity *= 2;
+      }
+      broad_phase->keys = realloc(broad_phase->keys, capacity * sizeof(BroadPhaseKey));
+      assert(broad_phase->keys != NULL);
+      for(size_t i = broad_phase->key_capacity; i < capacity; i++){
+        broad_phase->keys[i] = (BroadPhaseKey){0, 0, false, 0};
+      }
+      broad_phase->key_capacity = capacity;
+    }
+    // Keys must be distinct
+    assert(broad_phase->keys[key].call != broad_phase->call);
+    broad_phase->keys[key].id = id;
+    broad_phase->keys[key].call = broad_phase->call;
+  }
+}
+
+// Returns whether a key was given on this call
+bool broad_phase_key_given(BroadPhase *broad_phase, size_t key){
+  return broad_phase->keys[key].call == broad_phase->call;
+}
+
+// Drops the keys that are gone from the sorted orders and appends the new
+// ones, keeping the order of the rest
+void sweep_sync(BroadPhase *broad_phase, size_t *keys, size_t count){
+  if(broad_phase->order_capacity < count){
+    broad_phase->order_capacity = count * 2;
+    for(size_t axis = 0; axis < 2; axis++){
+      broad_phase->order[axis] = realloc(broad_phase->order[axis],
+        broad_phase->order_capacity * sizeof(size_t));
+      assert(broad_phase->order[axis] != NULL);
+    }
+  }
+  size_t size = 0;
+  for(size_t axis = 0; axis < 2; axis++){
+    size_t *order = broad_phase->order[axis];
+    size = 0;
+    for(size_t i = 0; i < broad_phase->order_size; i++){
+      if(broad_phase_key_given(broad_phase, order[i])){
+        order[size] = order[i];
+        size++;
+      }
+      else{
+        broad_phase->keys[order[i]].listed = false;
+      }
+    }
+  }
+  for(size_t id = 0; id < count; id++){
+    size_t key = broad_phase_key_of(keys, id);
+    if(!broad_phase->keys[key].listed){
+      broad_phase->keys[key].listed = true;
+      broad_phase->order[0][size] = key;
+      broad_phase->order[1][size] = key;
+      size++;
+    }
+  }
+  broad_phase->order_size = size;
+}
+
+// Gets the box given with a key on this call
+AABB broad_phase_key_box(BroadPhase *broad_phase, AABB *boxes, size_t key){
+  return boxes[broad_phase->keys[key].id];
+}
+
+// Sorts the keys by the lower edges of their boxes on an axis. Boxes move
+// little between calls and keep their keys, so the order is nearly sorted
+// already and insertion sort takes about one pass.
+void sweep_sort(BroadPhase *broad_phase, AABB *boxes, size_t axis){
+  size_t *order = broad_phase->order[axis];
+  for(size_t i = 1; i < broad_phase->order_size; i++){
+    size_t key = order[i];
+    Scalar edge = sweep_min(broad_phase_key_box(broad_phase, boxes, key), axis);
+    size_t j = i;
+    while(j > 0 && edge < sweep_min(broad_phase_key_box(broad_phase, boxes, order[j - 1]), axis)){
+      order[j] = order[j - 1];
+      j--;
+      broad_phase->stats.swaps++;
+    }
+    order[j] = key;
+  }
+}
+
+// Sweeps along the axis the boxes' centers are more spread out on, checking
+// each box against the ones after it that start before it ends
+void broad_phase_sweep_pairs(BroadPhase *broad_phase, AABB *boxes, size_t *keys,
+  size_t count, BroadPhasePairHandler handler, void *aux){
+  broad_phase_sync_keys(broad_phase, keys, count);
+  sweep_sync(broad_phase, keys, count);
+  Vector sum = VEC_ZERO;
+  Vector sum_squares = VEC_ZERO;
+  for(size_t i = 0; i < count; i++){
+    Vector center = vec_multiply(0.5, vec_add(boxes[i].min, boxes[i].max));
+    sum = vec_add(sum, center);
+    sum_squares = vec_add(sum_squares, (Vector){center.x * center.x, center.y * center.y});
+  }
+  // Comparing count times the variance avoids a division
+  Scalar spread_x = sum_squares.x * count - sum.x * sum.x;
+  Scalar spread_y = sum_squares.y * count - sum.y * sum.y;
+  size_t axis = spread_y > spread_x ? 1 : 0;
+
+  // Both axes are kept sorted, so switching axes never needs a full sort
+  sweep_sort(broad_phase, boxes, 0);
+  sweep_sort(broad_phase, boxes, 1);
+  size_t *order = broad_phase->order[axis];
+  for(size_t i = 0; i < count; i++){
+    size_t id1 = broad_phase->keys[order[i]].id;
+    Scalar end = sweep_max(boxes[id1], axis);
+    for(size_t j = i + 1; j < count; j++){
+      size_t id2 = broad_phase->keys[order[j]].id;
+      if(sweep_min(boxes[id2], axis) > end){
+        break;
+      }
+      broad_phase_test(broad_phase, boxes, id1, id2, handler, aux);
+    }
+  }
+}
+
+// What a tree broad phase passes along while descending into its tree
+typedef struct tree_pair_context {
+  BroadPhase *broad_phase;
+  AABB *boxes;
+  BroadPhasePairHandler handler;
+  void *aux;
+} TreePairContext;
+
+// Checks a pair whose fattened boxes overlap, given by their keys,
+// against the actual boxes
+void tree_pair(size_t key1, size_t key2, TreePairContext *context){
+  BroadPhaseKey *keys = context->broad_phase->keys;
+  broad_phase_test(context->broad_phase, context->boxes, keys[key1].id, keys[key2].id,
+    context->handler, context->aux);
+}
+
+// Removes the keys that are gone from the tree, adds the new ones, and moves
+// the rest, then descends into the tree against itself
+void broad_phase_tree_pairs(BroadPhase *broad_phase, AABB *boxes, size_t *keys,
+  size_t count, BroadPhasePairHandler handler, void *aux){
+  AABBTree *tree = broad_phase->tree;
+  broad_phase_sync_keys(broad_phase, keys, count);
+  if(broad_phase->tree_capacity < count){
+    broad_phase->tree_capacity = count * 2;
+    broad_phase->tree_keys = realloc(broad_phase->tree_keys,
+      broad_phase->tree_capacity * sizeof(size_t));
+    assert(broad_phase->tree_keys != NULL);
+  }
+  size_t size = 0;
+  for(size_t i = 0; i < broad_phase->tree_size; i++){
+    size_t key = broad_phase->tree_keys[i];
+    BroadPhaseKey *entry = &broad_phase->keys[key];
+    if(!broad_phase_key_given(broad_phase, key)){
+      aabb_tree_remove(tree, entry->proxy);
+      entry->listed = false;
+      continue;
+    }
+    broad_phase->tree_keys[size] = key;
+    size++;
+    if(aabb_tree_move(tree, entry->proxy, boxes[entry->id])){
+      broad_phase->stats.swaps++;
+    }
+  }
+  for(size_t id = 0; id < count; id++){
+    size_t key = broad_phase_key_of(keys, id);
+    BroadPhaseKey *entry = &broad_phase->keys[key];
+    if(!entry->listed){
+      entry->listed = true;
+      entry->proxy = aabb_tree_insert(tree, boxes[id], key);
+      broad_phase->tree_keys[size] = key;
+      size++;
+    }
+  }
+  broad_phase->tree_size = size;
+  TreePairContext context = {broad_phase, boxes, handler, aux};
+  aabb_tree_find_pairs(tree, (AABBTreePairHandler) tree_pair, &context);
+}
+
+size_t broad_phase_find_pairs(BroadPhase *broad_phase, AABB *boxes, size_t *keys,
+  size_t count, BroadPhasePairHandler handler, void *aux){
+  broad_phase->stats = (BroadPhaseStats){count, 0, 0, 0};
+  if(broad_phase->kind == BROAD_PHASE_GRID){
+    broad_phase_grid_pairs(broad_phase, boxes, count, handler, aux);
+  }
+  else if(broad_phase->kind == BROAD_PHASE_SWEEP){
+    broad_phase_sweep_pairs(broad_phase, boxes, keys, count, handler, aux);
+  }
+  else if(broad_phase->kind == BROAD_PHASE_TREE){
+    broad_phase_tree_pairs(broad_phase, boxes, keys, count, handler, aux);
+  }
+  else{
+    broad_phase_all_pairs(broad_phase, boxes, count, handler, aux);
+  }
+  return broad_phase->stats.pairs;
+}
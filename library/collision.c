@@ -4,6 +4,9 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include "arena.h"
+#include "simd.h"
+#include "shape.h"
 
 struct bounding_box {
   Bounds x_bounds;
@@ -12,12 +15,11 @@ struct bounding_box {
 
 struct projection_info {
   bool collided;
-  double overlap;
+  Scalar overlap;
 };
 
 BoundingBox *bounding_init(Bounds x_bounds, Bounds y_bounds){
-  BoundingBox* bounding_box = malloc(sizeof(BoundingBox));
-  assert(bounding_box != NULL);
+  BoundingBox* bounding_box = frame_alloc(sizeof(BoundingBox));
   bounding_box->x_bounds = x_bounds;
   bounding_box->y_bounds = y_bounds;
   return bounding_box;
@@ -31,19 +33,10 @@ Bounds get_y_bounds(BoundingBox *bounding_box){
   return bounding_box->y_bounds;
 }
 
-Bounds find_y_bounds(List *shape){
-  double y_min = INFINITY;
-  double y_max = -INFINITY;
-  for(size_t i = 0; i < list_size(shape); i++){
-    Vector point = *(Vector*)list_get(shape, i);
-    if(point.y < y_min){
-      y_min = point.y;
-    }
-    if(point.y > y_max){
-      y_max = point.y;
-    }
-  }
-  return (Bounds){y_min, y_max};
+Bounds find_y_bounds(Polygon *shape){
+  Vector min, max;
+  simd_bounds(polygon_vertices(shape), polygon_size(shape), &min, &max);
+  return (Bounds){min.y, max.y};
 }
 
 // Returns the unit vector of a given vector v
@@ -57,27 +50,10 @@ Vector normal_vector(Vector v){
 }
 
 // Finds the boundaries (x_min, x_max and y_min, y_max) coordinates of a shape
-BoundingBox *find_boundaries(List *shape){
-  double x_min = INFINITY;
-  double x_max = -INFINITY;
-  double y_min = INFINITY;
-  double y_max = -INFINITY;
-  for(size_t i = 0; i < list_size(shape); i++){
-    Vector point = *(Vector*)list_get(shape, i);
-    if(point.x < x_min){
-      x_min = point.x;
-    }
-    if(point.x > x_max){
-      x_max = point.x;
-    }
-    if(point.y < y_min){
-      y_min = point.y;
-    }
-    if(point.y > y_max){
-      y_max = point.y;
-    }
-  }
-  return bounding_init((Bounds){x_min, x_max}, (Bounds){y_min, y_max});
+BoundingBox *find_boundaries(Polygon *shape){
+  Vector min, max;
+  simd_bounds(polygon_vertices(shape), polygon_size(shape), &min, &max);
+  return bounding_init((Bounds){min.x, max.x}, (Bounds){min.y, max.y});
 }
 
 // Checks if there's any points in the bounds that overlap by checking whether
@@ -117,64 +93,262 @@ bool check_bounds_collision(BoundingBox *box1, BoundingBox *box2){
 // Finds the projection of a shape on an axis by computing the dot product
 // of each point with the axis and finding the minimum and maximum projection
 // Returns a Bounds object.
-Bounds find_projection(List *shape, Vector axis){
-  double min = INFINITY;
-  double max = -INFINITY;
-  for(size_t i = 0; i < list_size(shape); i++){
-    double p = vec_dot(axis, *(Vector*)list_get(shape, i));
-    if(p < min){
-      min = p;
+Bounds find_projection(Polygon *shape, Vector axis){
+  Scalar min, max;
+  simd_project(polygon_vertices(shape), polygon_size(shape), axis, &min, &max);
+  return (Bounds){min, max};
+}
+
+// Returns how far two intervals overlap, which is negative if they are apart
+Scalar interval_overlap(Bounds bounds1, Bounds bounds2){
+  Scalar forward = bounds1.max - bounds2.min;
+  Scalar backward = bounds2.max - bounds1.min;
+  return forward < backward ? forward : backward;
+}
+
+// This function is used if the BoundingBox of each shape intersects with one
+// another. Checks to see if the projections of the shapes overlap on every
+// one of the given axes, using the separating axis theorem, and keeps the
+// axis they overlap least along in best, pointing from shape1 to shape2.
+// Returns false as soon as any of the projections do not overlap, leaving
+// that separating axis in best.
+bool check_axes_overlap(Polygon *shape1, Polygon *shape2, Vector *axes, size_t count, CollisionInfo *best){
+  for(size_t i = 0; i < count; i++) {
+    Bounds proj1 = find_projection(shape1, axes[i]);
+    Bounds proj2 = find_projection(shape2, axes[i]);
+    Scalar overlap = interval_overlap(proj1, proj2);
+    if(overlap < 0){
+      *best = (CollisionInfo){false, 0, axes[i]};
+      return false;
     }
-    if(p > max){
-      max = p;
+    if(overlap < best->overlap){
+      bool backwards = proj2.min + proj2.max < proj1.min + proj1.max;
+      *best = (CollisionInfo){true, overlap, backwards ? vec_negate(axes[i]) : axes[i]};
     }
   }
-  return (Bounds){min, max};
+  return true;
 }
 
-// This function is used if the BoundingBox of each shape intersects with one
-// another. Checks to see if any of the projections of the shapes overlap on all the
-// axes (the normal vectors) produced by the edges. This function uses
-// the separting axis theorem. Returns false if any of the projection does not
-// overlap.
-CollisionInfo check_projection_overlap(List* shape1, List* shape2){
-  double min = INFINITY;
-  Vector axis;
-  for(size_t i = 0; i < list_size(shape1) - 1; i++) {
-    Vector v1 = *(Vector*)list_get(shape1, i);
-    Vector v2 = *(Vector*)list_get(shape1, i+1);
-    Vector edge = vec_subtract(v1, v2);
-    Vector normal = unit_vector(normal_vector(edge));
-    Bounds proj1 = find_projection(shape1, normal);
-    Bounds proj2 = find_projection(shape2, normal);
-    ProjectionInfo proj_info = check_one_dimension_bounds(proj1, proj2);
-    if(!proj_info.collided){
-      return (CollisionInfo){false, 0, (Vector){0, 0}};
+// Checks overlapping projections between two shapes on both shapes' axes
+CollisionInfo check_overlap_on_axes(Polygon *shape1, Vector *axes1, size_t count1,
+  Polygon *shape2, Vector *axes2, size_t count2){
+  CollisionInfo info = {true, INFINITY, (Vector){0, 0}};
+  if(check_axes_overlap(shape1, shape2, axes1, count1, &info)){
+    check_axes_overlap(shape1, shape2, axes2, count2, &info);
+  }
+  return info;
+}
+
+// Checks overlapping projections between two shapes on the normal vectors
+// of all the edges of shape1 and shape2, which are found on the spot
+CollisionInfo check_overlap(Polygon *shape1, Polygon* shape2){
+  ArenaMark mark = arena_mark(frame_arena());
+  Vector *axes1 = frame_alloc(polygon_size(shape1) * sizeof(Vector));
+  Vector *axes2 = frame_alloc(polygon_size(shape2) * sizeof(Vector));
+  size_t count1 = polygon_edge_normals(shape1, axes1);
+  size_t count2 = polygon_edge_normals(shape2, axes2);
+  CollisionInfo info = check_overlap_on_axes(shape1, axes1, count1, shape2, axes2, count2);
+  arena_rewind(frame_arena(), mark);
+  return info;
+}
+
+// Pairs of polygons with more vertices than this between them are checked
+// with GJK instead of SAT when the narrow phase is chosen automatically
+const size_t GJK_VERTEX_THRESHOLD = 48;
+// Bounds the work done for shapes that are almost touching
+const size_t GJK_MAX_ITERATIONS = 32;
+const size_t EPA_MAX_ITERATIONS = 32;
+
+// Returns the vertex of a polygon furthest along a direction
+Vector polygon_support(Polygon *shape, Vector direction){
+  Vector *vertices = polygon_vertices(shape);
+  size_t size = polygon_size(shape);
+  size_t best = 0;
+  Scalar best_dot = vec_dot(vertices[0], direction);
+  for(size_t i = 1; i < size; i++){
+    Scalar dot = vec_dot(vertices[i], direction);
+    if(dot > best_dot){
+      best = i;
+      best_dot = dot;
+    }
+  }
+  return vertices[best];
+}
+
+// Returns the point of the Minkowski difference shape1 - shape2 furthest
+// along a direction
+Vector minkowski_support(Polygon *shape1, Polygon *shape2, Vector direction){
+  return vec_subtract(polygon_support(shape1, direction),
+    polygon_support(shape2, vec_negate(direction)));
+}
+
+// Returns the perpendicular of an edge that points towards a point
+Vector perpendicular_towards(Vector edge, Vector towards){
+  Vector perpendicular = normal_vector(edge);
+  return vec_dot(perpendicular, towards) < 0 ? vec_negate(perpendicular) : perpendicular;
+}
+
+// Reduces a GJK simplex (newest point last) to the part nearest the origin
+// and sets the next search direction towards it.
+// Returns true if the simplex contains the origin.
+bool gjk_update_simplex(Vector *simplex, size_t *size, Vector *direction){
+  Vector a = simplex[*size - 1];
+  Vector to_origin = vec_negate(a);
+  if(*size == 2){
+    Vector ab = vec_subtract(simplex[0], a);
+    if(vec_dot(ab, to_origin) <= 0){
+      simplex[0] = a;
+      *size = 1;
+      *direction = to_origin;
+      return false;
+    }
+    *direction = perpendicular_towards(ab, to_origin);
+    // The origin lies on the segment, so the shapes touch
+    return vec_dot(*direction, to_origin) == 0;
+  }
+  Vector b = simplex[1], c = simplex[0];
+  Vector ab = vec_subtract(b, a), ac = vec_subtract(c, a);
+  Vector ab_out = vec_negate(perpendicular_towards(ab, ac));
+  Vector ac_out = vec_negate(perpendicular_towards(ac, ab));
+  if(vec_dot(ab_out, to_origin) > 0){
+    simplex[0] = b;
+    simplex[1] = a;
+    *size = 2;
+    *direction = ab_out;
+    return false;
+  }
+  if(vec_dot(ac_out, to_origin) > 0){
+    simplex[1] = a;
+    *size = 2;
+    *direction = ac_out;
+    return false;
+  }
+  return true;
+}
+
+// Finds how far and along which axis the shapes overlap with the expanding
+// polytope algorithm, starting from a triangle around the origin
+CollisionInfo epa_penetration(Polygon *shape1, Polygon *shape2, Vector *simplex){
+  ArenaMark mark = arena_mark(frame_arena());
+  Vector *polytope = frame_alloc((3 + EPA_MAX_ITERATIONS) * sizeof(Vector));
+  size_t size = 3;
+  // Keeps the polytope counterclockwise so edge normals point outwards
+  polytope[0] = simplex[0];
+  bool clockwise = vec_cross(vec_subtract(simplex[1], simplex[0]), vec_subtract(simplex[2], simplex[0])) < 0;
+  polytope[1] = clockwise ? simplex[2] : simplex[1];
+  polytope[2] = clockwise ? simplex[1] : simplex[2];
+
+  CollisionInfo info = {true, INFINITY, (Vector){0, 1}};
+  for(size_t iteration = 0; iteration <= EPA_MAX_ITERATIONS; iteration++){
+    // Finds the edge closest to the origin
+    size_t closest = 0;
+    info.overlap = INFINITY;
+    for(size_t i = 0; i < size; i++){
+      Vector edge = vec_subtract(polytope[(i + 1) % size], polytope[i]);
+      Scalar length = vec_magnitude(edge);
+      if(length == 0){
+        continue;
+      }
+      Vector normal = vec_multiply(1.0 / length, (Vector){edge.y, -edge.x});
+      Scalar distance = vec_dot(normal, polytope[i]);
+      if(distance < info.overlap){
+        closest = i;
+        info.overlap = distance;
+        info.axis = normal;
+      }
     }
-    if(proj_info.overlap < min){
-      min = proj_info.overlap;
-      axis = normal;
+    // Stops once the polytope cannot grow any further towards that edge
+    Vector support = minkowski_support(shape1, shape2, info.axis);
+    Scalar growth = vec_dot(support, info.axis) - info.overlap;
+    if(growth <= SCALAR_EPSILON * (1 + fabs(info.overlap)) || iteration == EPA_MAX_ITERATIONS){
+      break;
     }
+    for(size_t i = size; i > closest + 1; i--){
+      polytope[i] = polytope[i - 1];
+    }
+    polytope[closest + 1] = support;
+    size++;
+  }
+  arena_rewind(frame_arena(), mark);
+  // The Minkowski difference is shape1 - shape2, so its outward normal
+  // nearest the origin points from shape1 towards shape2
+  if(info.overlap < 0){
+    info.overlap = 0;
   }
-  return (CollisionInfo){true, min, axis};
+  return info;
 }
 
-// Checks overlapping projections between two shapes on both the normal vectors
-// produced by shape1 and shape2.
-CollisionInfo check_overlap(List *shape1, List* shape2){
-  CollisionInfo info1 = check_projection_overlap(shape1, shape2);
-  Vector axis1 = info1.axis;
-  CollisionInfo info2 = check_projection_overlap(shape2, shape1);
-  Vector axis2 = info2.axis;
-  if(info1.collided && info2.collided){
-    if(info1.overlap < info2.overlap){
-      return (CollisionInfo){true, info1.overlap, axis1};
+// Reports two shapes as apart along a direction pointing from shape1 to shape2
+CollisionInfo gjk_separated(Vector direction){
+  return (CollisionInfo){false, 0, vec_multiply(1.0 / vec_magnitude(direction), direction)};
+}
+
+CollisionInfo find_gjk_collision(Polygon *shape1, Polygon *shape2){
+  Vector simplex[3];
+  size_t size = 1;
+  Vector direction = vec_subtract(polygon_get(shape2, 0), polygon_get(shape1, 0));
+  if(direction.x == 0 && direction.y == 0){
+    direction = (Vector){1, 0};
+  }
+  simplex[0] = minkowski_support(shape1, shape2, direction);
+  direction = vec_negate(simplex[0]);
+  bool contains = direction.x == 0 && direction.y == 0;
+  for(size_t iteration = 0; !contains && iteration < GJK_MAX_ITERATIONS; iteration++){
+    Vector point = minkowski_support(shape1, shape2, direction);
+    Scalar reach = vec_dot(point, direction);
+    if(reach < 0){
+      // No point of shape1 reaches as far along the direction as shape2
+      // starts, so it is a separating axis, pointing from shape1 to shape2
+      return gjk_separated(direction);
+    }
+    // A point no further along the direction than the simplex already is
+    // cannot bring it any closer to the origin, which the simplex does not
+    // contain: the shapes are at most touching to within rounding, and going
+    // on would only cycle through the same points
+    Scalar furthest = vec_dot(simplex[0], direction);
+    for(size_t i = 1; i < size; i++){
+      furthest = fmax(furthest, vec_dot(simplex[i], direction));
     }
-    else {
-      return (CollisionInfo){true, info2.overlap, vec_negate(axis2)};
+    if(reach - furthest <= SCALAR_EPSILON * vec_magnitude(direction)){
+      return gjk_separated(direction);
     }
+    simplex[size] = point;
+    size++;
+    contains = gjk_update_simplex(simplex, &size, &direction);
   }
-  return (CollisionInfo){false, 0, (Vector){0, 0}};
+  if(!contains){
+    // Ran out of iterations without enclosing the origin, so the overlap,
+    // if any, is too slight to find
+    return gjk_separated(direction);
+  }
+
+  // The shapes touch or overlap; EPA needs a whole triangle around the
+  // origin, so a degenerate simplex is widened first
+  while(size < 3){
+    Vector edge = size == 2 ? vec_subtract(simplex[1], simplex[0]) : (Vector){1, 0};
+    Vector perpendicular = normal_vector(edge);
+    Vector point = minkowski_support(shape1, shape2, perpendicular);
+    if(vec_dot(point, perpendicular) <= vec_dot(simplex[0], perpendicular)){
+      point = minkowski_support(shape1, shape2, vec_negate(perpendicular));
+    }
+    simplex[size] = point;
+    size++;
+  }
+  return epa_penetration(shape1, shape2, simplex);
+}
+
+// Checks two polygons with the given narrow phase, choosing by their vertex
+// counts when it is NARROW_PHASE_AUTO
+CollisionInfo check_polygon_overlap(Polygon *shape1, Vector *axes1, size_t count1,
+  Polygon *shape2, Vector *axes2, size_t count2, NarrowPhase narrow_phase){
+  if(narrow_phase == NARROW_PHASE_AUTO){
+    narrow_phase = polygon_size(shape1) + polygon_size(shape2) > GJK_VERTEX_THRESHOLD
+      ? NARROW_PHASE_GJK : NARROW_PHASE_SAT;
+  }
+  if(narrow_phase == NARROW_PHASE_GJK){
+    return find_gjk_collision(shape1, shape2);
+  }
+  return check_overlap_on_axes(shape1, axes1, count1, shape2, axes2, count2);
 }
 
 // The main collision detector.
@@ -184,18 +358,375 @@ CollisionInfo check_overlap(List *shape1, List* shape2){
 // If the bounding boxes overlap, then the separate axis theorem is used to
 // check for collision by checking if there exists an axis on which the
 // projections of the two shapes do not overlap
-CollisionInfo find_collision(List *shape1, List *shape2){
+CollisionInfo find_collision(Polygon *shape1, Polygon *shape2){
+  // The bounding boxes are only needed here, so they are released right away
+  // rather than piling up in the frame arena over thousands of pair tests
+  ArenaMark mark = arena_mark(frame_arena());
   BoundingBox *bounds1 = find_boundaries(shape1);
   BoundingBox *bounds2 = find_boundaries(shape2);
   bool bounds = check_bounds_collision(bounds1, bounds2);
-  free(bounds1);
-  free(bounds2);
+  arena_rewind(frame_arena(), mark);
   if(!bounds){
     return (CollisionInfo){false, 0, (Vector){0, 0}};
   }
-  CollisionInfo info = check_overlap(shape1, shape2);
+  CollisionInfo info = polygon_size(shape1) + polygon_size(shape2) > GJK_VERTEX_THRESHOLD
+    ? find_gjk_collision(shape1, shape2) : check_overlap(shape1, shape2);
   if(!info.collided){
     return (CollisionInfo){false, 0, (Vector){0, 0}};
   }
   return (CollisionInfo){true, 0, info.axis};
 }
+
+CollisionInfo find_circle_collision(Vector center1, Scalar radius1, Vector center2, Scalar radius2){
+  Vector between = vec_subtract(center2, center1);
+  Scalar reach = radius1 + radius2;
+  Scalar distance_squared = vec_dot(between, between);
+  Scalar distance = sqrt(distance_squared);
+  if(distance > reach){
+    return (CollisionInfo){false, 0, vec_multiply(1.0 / distance, between)};
+  }
+  // Concentric circles can be pushed apart in any direction
+  Vector axis = distance > 0 ? vec_multiply(1.0 / distance, between) : (Vector){0, 1};
+  return (CollisionInfo){true, reach - distance, axis};
+}
+
+CollisionInfo find_circle_polygon_collision(Vector center, Scalar radius, Polygon *shape){
+  // Finds the point on the outline closest to the center, and whether the
+  // center is on the same side of every edge (i.e. inside the polygon)
+  Vector *vertices = polygon_vertices(shape);
+  size_t size = polygon_size(shape);
+  Vector closest = vertices[0];
+  Scalar closest_squared = INFINITY;
+  bool left = true, right = true;
+  for(size_t i = 0; i < size; i++){
+    Vector start = vertices[i];
+    Vector edge = vec_subtract(vertices[(i + 1) % size], start);
+    Vector offset = vec_subtract(center, start);
+    Scalar side = vec_cross(edge, offset);
+    left = left && side >= 0;
+    right = right && side <= 0;
+    Scalar length_squared = vec_dot(edge, edge);
+    Scalar t = length_squared > 0 ? vec_dot(offset, edge) / length_squared : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    Vector point = vec_add(start, vec_multiply(t, edge));
+    Vector gap = vec_subtract(center, point);
+    Scalar gap_squared = vec_dot(gap, gap);
+    if(gap_squared < closest_squared){
+      closest_squared = gap_squared;
+      closest = point;
+    }
+  }
+  bool inside = left || right;
+  Scalar distance = sqrt(closest_squared);
+  if(!inside && distance > radius){
+    // The polygon is convex, so the direction to its closest point separates
+    return (CollisionInfo){false, 0, vec_multiply(1.0 / distance, vec_subtract(closest, center))};
+  }
+
+  // The axis points from the circle towards the polygon: towards the closest
+  // point from outside, and away from the nearest edge from inside
+  Vector axis;
+  if(distance > 0){
+    axis = vec_multiply((inside ? -1.0 : 1.0) / distance, vec_subtract(closest, center));
+  }
+  else{
+    // The center is on the outline, so it is pushed out past the centroid
+    axis = unit_vector(vec_subtract(polygon_centroid(shape), center));
+  }
+  Scalar overlap = inside ? radius + distance : radius - distance;
+  return (CollisionInfo){true, overlap, axis};
+}
+
+// Returns the center of a box
+Vector aabb_center(AABB box){
+  return vec_multiply(0.5, vec_add(box.min, box.max));
+}
+
+CollisionInfo find_box_collision(AABB box1, AABB box2){
+  Scalar x_overlap = interval_overlap((Bounds){box1.min.x, box1.max.x}, (Bounds){box2.min.x, box2.max.x});
+  Scalar y_overlap = interval_overlap((Bounds){box1.min.y, box1.max.y}, (Bounds){box2.min.y, box2.max.y});
+  if(x_overlap < 0 || y_overlap < 0){
+    return (CollisionInfo){false, 0, x_overlap < 0 ? (Vector){1, 0} : (Vector){0, 1}};
+  }
+  Vector between = vec_subtract(aabb_center(box2), aabb_center(box1));
+  if(x_overlap < y_overlap){
+    return (CollisionInfo){true, x_overlap, (Vector){between.x < 0 ? -1 : 1, 0}};
+  }
+  return (CollisionInfo){true, y_overlap, (Vector){0, between.y < 0 ? -1 : 1}};
+}
+
+CollisionInfo find_box_polygon_collision(AABB box, Polygon *shape, Vector *axes, size_t count){
+  // The box's own axes are the world axes, which the polygon's bounds
+  // already project it onto
+  Vector shape_min, shape_max;
+  simd_bounds(polygon_vertices(shape), polygon_size(shape), &shape_min, &shape_max);
+  CollisionInfo info = find_box_collision(box, (AABB){shape_min, shape_max});
+  if(!info.collided){
+    return info;
+  }
+
+  // The box projects onto any other axis as its center plus or minus
+  // its half extents along that axis
+  Vector center = aabb_center(box);
+  Vector half = vec_multiply(0.5, vec_subtract(box.max, box.min));
+  for(size_t i = 0; i < count; i++){
+    Vector normal = axes[i];
+    // Axes along the world axes were covered by the bounds
+    if(normal.x == 0 || normal.y == 0){
+      continue;
+    }
+    Scalar radius = half.x * fabs(normal.x) + half.y * fabs(normal.y);
+    Scalar middle = vec_dot(center, normal);
+    Bounds projection = find_projection(shape, normal);
+    Scalar overlap = interval_overlap((Bounds){middle - radius, middle + radius}, projection);
+    if(overlap < 0){
+      return (CollisionInfo){false, 0, normal};
+    }
+    if(overlap < info.overlap){
+      // Points the axis from the box towards the polygon
+      Scalar direction = projection.min + projection.max - 2 * middle;
+      info = (CollisionInfo){true, overlap, direction < 0 ? vec_negate(normal) : normal};
+    }
+  }
+  return info;
+}
+
+CollisionInfo find_circle_box_collision(Vector center, Scalar radius, AABB box){
+  Vector closest = {
+    center.x < box.min.x ? box.min.x : (center.x > box.max.x ? box.max.x : center.x),
+    center.y < box.min.y ? box.min.y : (center.y > box.max.y ? box.max.y : center.y)
+  };
+  Vector gap = vec_subtract(closest, center);
+  Scalar gap_squared = vec_dot(gap, gap);
+  if(gap_squared > 0){
+    Scalar distance = sqrt(gap_squared);
+    if(distance > radius){
+      return (CollisionInfo){false, 0, vec_multiply(1.0 / distance, gap)};
+    }
+    return (CollisionInfo){true, radius - distance, vec_multiply(1.0 / distance, gap)};
+  }
+
+  // The center is inside, so the circle is pushed out of the nearest side
+  // and the axis points back into the box
+  Scalar depths[] = {center.x - box.min.x, box.max.x - center.x,
+    center.y - box.min.y, box.max.y - center.y};
+  Vector axes[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  size_t nearest = 0;
+  for(size_t i = 1; i < 4; i++){
+    if(depths[i] < depths[nearest]){
+      nearest = i;
+    }
+  }
+  return (CollisionInfo){true, radius + depths[nearest], axes[nearest]};
+}
+
+// Gets the box a body collides within, which for a circle is the circle's
+// own rather than that of the polygon it is drawn with
+AABB body_collision_bounds(Body *body){
+  if(body_is_circle(body)){
+    Vector center = body_get_centroid(body);
+    Vector reach = {body_get_radius(body), body_get_radius(body)};
+    return (AABB){vec_subtract(center, reach), vec_add(center, reach)};
+  }
+  return body_get_bounds(body);
+}
+
+// Checks a circle body against any other body, with the axis pointing from
+// the circle towards the other body
+CollisionInfo find_circle_body_collision(Body *circle, Body *body){
+  Vector center = body_get_centroid(circle);
+  Scalar radius = body_get_radius(circle);
+  if(body_is_circle(body)){
+    return find_circle_collision(center, radius, body_get_centroid(body), body_get_radius(body));
+  }
+  if(body_is_box(body)){
+    return find_circle_box_collision(center, radius, body_get_bounds(body));
+  }
+  return find_circle_polygon_collision(center, radius, body_get_collision_shape(body));
+}
+
+// Checks a box body against a body that is not a circle, with the axis
+// pointing from the box towards the other body
+CollisionInfo find_box_body_collision(Body *box, Body *body){
+  if(body_is_box(body)){
+    return find_box_collision(body_get_bounds(box), body_get_bounds(body));
+  }
+  size_t count;
+  Vector *axes = body_get_axes(body, &count);
+  return find_box_polygon_collision(body_get_bounds(box), body_get_collision_shape(body), axes, count);
+}
+
+// Flips a collision's axis so it points the other way between the bodies
+CollisionInfo collision_reverse(CollisionInfo info){
+  info.axis = vec_negate(info.axis);
+  return info;
+}
+
+/**
+ * Holds a piece of one body moved into the frame of another while it is
+ * checked against that body's pieces. Created on first use.
+ */
+Polygon *piece_scratch = NULL;
+
+// Returns whether a body's prototype is split into several convex pieces
+bool body_is_pieced(Body *body){
+  size_t count;
+  shape_prototype_get_pieces(body_get_prototype(body), &count);
+  return count > 1;
+}
+
+// Keeps the deeper of two collisions, or the first if neither happened
+CollisionInfo collision_deeper(CollisionInfo best, CollisionInfo info){
+  if(info.collided && (!best.collided || info.overlap > best.overlap)){
+    return info;
+  }
+  return best;
+}
+
+// Checks a body made of several convex pieces against any other body, with
+// the axis pointing from the pieced body towards the other one.
+// The other body (piece by piece, if it is pieced too) is moved into the
+// pieced body's frame, and only pairs of pieces whose bounding circles
+// overlap are checked. The deepest overlap of any pair is reported.
+CollisionInfo find_pieces_collision(Body *pieced, Body *body, NarrowPhase narrow_phase){
+  size_t count;
+  ShapePiece *pieces = shape_prototype_get_pieces(body_get_prototype(pieced), &count);
+  Transform2D to_local = transform_invert(body_get_transform(pieced));
+  CollisionInfo best = {false, 0, (Vector){0, 0}};
+
+  if(body_is_circle(body)){
+    Vector center = transform_apply(to_local, body_get_centroid(body));
+    Scalar radius = body_get_radius(body);
+    for(size_t i = 0; i < count; i++){
+      Vector between = vec_subtract(center, pieces[i].center);
+      Scalar reach = radius + pieces[i].radius;
+      if(vec_dot(between, between) > reach * reach){
+        continue;
+      }
+      CollisionInfo info = find_circle_polygon_collision(center, radius, pieces[i].shape);
+      best = collision_deeper(best, collision_reverse(info));
+    }
+  }
+  else{
+    if(piece_scratch == NULL){
+      piece_scratch = polygon_init(8);
+    }
+    size_t other_count;
+    ShapePiece *others = shape_prototype_get_pieces(body_get_prototype(body), &other_count);
+    Transform2D other_to_local = transform_compose(to_local, body_get_transform(body));
+    for(size_t j = 0; j < other_count; j++){
+      ShapePiece *other = &others[j];
+      Vector center = transform_apply(other_to_local, other->center);
+      bool moved = false;
+      ArenaMark mark = arena_mark(frame_arena());
+      Vector *axes = frame_alloc(other->axis_count * sizeof(Vector));
+      for(size_t i = 0; i < count; i++){
+        Vector between = vec_subtract(center, pieces[i].center);
+        Scalar reach = other->radius + pieces[i].radius;
+        if(vec_dot(between, between) > reach * reach){
+          continue;
+        }
+        // The other piece is only moved once one of its neighbours is close
+        if(!moved){
+          polygon_copy_transformed(piece_scratch, other->shape, other_to_local);
+          simd_transform(other->axes, axes, other->axis_count,
+            other_to_local.cos_angle, other_to_local.sin_angle, VEC_ZERO);
+          moved = true;
+        }
+        CollisionInfo info = check_polygon_overlap(pieces[i].shape, pieces[i].axes,
+          pieces[i].axis_count, piece_scratch, axes, other->axis_count, narrow_phase);
+        best = collision_deeper(best, info);
+      }
+      arena_rewind(frame_arena(), mark);
+    }
+  }
+
+  // Turns the axis back into the scene's frame
+  if(best.collided){
+    Transform2D rotation = body_get_transform(pieced);
+    rotation.translation = VEC_ZERO;
+    best.axis = transform_apply(rotation, best.axis);
+  }
+  return best;
+}
+
+// Checks two bodies whose bounding boxes overlap with the cheapest test
+// their shapes allow, using the given narrow phase for two polygons
+CollisionInfo find_narrow_collision(Body *body1, Body *body2, NarrowPhase narrow_phase){
+  // Concave bodies are checked a convex piece at a time
+  if(body_is_pieced(body1)){
+    return find_pieces_collision(body1, body2, narrow_phase);
+  }
+  if(body_is_pieced(body2)){
+    return collision_reverse(find_pieces_collision(body2, body1, narrow_phase));
+  }
+  // Circles and boxes are checked in closed form, in that order of preference
+  if(body_is_circle(body1)){
+    return find_circle_body_collision(body1, body2);
+  }
+  if(body_is_circle(body2)){
+    return collision_reverse(find_circle_body_collision(body2, body1));
+  }
+  if(body_is_box(body1)){
+    return find_box_body_collision(body1, body2);
+  }
+  if(body_is_box(body2)){
+    return collision_reverse(find_box_body_collision(body2, body1));
+  }
+  size_t count1, count2;
+  Vector *axes1 = body_get_axes(body1, &count1);
+  Vector *axes2 = body_get_axes(body2, &count2);
+  return check_polygon_overlap(body_get_collision_shape(body1), axes1, count1,
+    body_get_collision_shape(body2), axes2, count2, narrow_phase);
+}
+
+CollisionInfo find_body_collision(Body *body1, Body *body2){
+  if(!aabb_overlap(body_collision_bounds(body1), body_collision_bounds(body2))){
+    return (CollisionInfo){false, 0, (Vector){0, 0}};
+  }
+  return find_narrow_collision(body1, body2, NARROW_PHASE_AUTO);
+}
+
+/**
+ * How often find_body_collision_cached() has been able to reuse an axis.
+ */
+SeparatingAxisStats separating_axis_stats = {0, 0, 0};
+
+// Projects a body's collision shape onto an axis
+Bounds body_projection(Body *body, Vector axis){
+  if(body_is_circle(body)){
+    Scalar middle = vec_dot(body_get_centroid(body), axis);
+    return (Bounds){middle - body_get_radius(body), middle + body_get_radius(body)};
+  }
+  return find_projection(body_get_collision_shape(body), axis);
+}
+
+CollisionInfo find_body_collision_cached(Body *body1, Body *body2, SeparatingAxisCache *cache,
+  NarrowPhase narrow_phase){
+  if(!aabb_overlap(body_collision_bounds(body1), body_collision_bounds(body2))){
+    return (CollisionInfo){false, 0, (Vector){0, 0}};
+  }
+  if(cache->valid){
+    separating_axis_stats.lookups++;
+    Bounds proj1 = body_projection(body1, cache->axis);
+    Bounds proj2 = body_projection(body2, cache->axis);
+    if(interval_overlap(proj1, proj2) < 0){
+      separating_axis_stats.hits++;
+      return (CollisionInfo){false, 0, cache->axis};
+    }
+  }
+  separating_axis_stats.full_checks++;
+  CollisionInfo info = find_narrow_collision(body1, body2, narrow_phase);
+  // Every kernel reports the axis that separated the bodies, if any
+  cache->valid = !info.collided && (info.axis.x != 0 || info.axis.y != 0);
+  cache->axis = info.axis;
+  return info;
+}
+
+SeparatingAxisStats separating_axis_get_stats(void){
+  return separating_axis_stats;
+}
+
+void separating_axis_reset_stats(void){
+  separating_axis_stats = (SeparatingAxisStats){0, 0, 0};
+}
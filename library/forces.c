@@ -4,8 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include "pool.h"
 
-const double MIN_DISTANCE = 5;
+const Scalar MIN_DISTANCE = 5;
 
 const int DEBUG = 0;
 // 0 is false 1 is true. When true, all assert statements and print statements
@@ -24,54 +25,58 @@ const int DEBUG = 0;
  * @param body2 the second body
  */
 
- PartialData *partial_data_init(double elasticity, bool partial){
-   PartialData *partial_data = malloc(sizeof(PartialData));
-   assert(partial_data != NULL);
+/**
+ * The pools the data of force creators and collisions are allocated from,
+ * each created on first use.
+ */
+Pool *partial_data_pool = NULL;
+Pool *force_data_pool = NULL;
+// The number of objects each pool allocates space for at a time
+const size_t FORCES_POOL_BLOCK = 256;
+
+ PartialData *partial_data_init(Scalar elasticity, bool partial){
+   if(partial_data_pool == NULL){
+     partial_data_pool = pool_init("PartialData", sizeof(PartialData), FORCES_POOL_BLOCK);
+   }
+   PartialData *partial_data = pool_alloc(partial_data_pool);
    partial_data->elasticity = elasticity;
    partial_data->partial = partial;
    return partial_data;
  }
 
-ForceData *force_data_init(double force_constant, Body *body1, Body *body2){
-  ForceData *force_data = malloc(sizeof(ForceData));
-  assert(force_data != NULL);
-  force_data->force_constant = force_constant;
-  force_data->body1 = body1;
-  force_data->body2 = body2;
-  return force_data;
+void partial_data_free(PartialData *data){
+  pool_release(partial_data_pool, data);
 }
 
-CollisionData *collision_data_init(CollisionHandler handler, void* aux,
-  bool colliding, FreeFunc freer, Body *body1, Body *body2){
-  CollisionData *collision_data = malloc(sizeof(CollisionData));
-  assert(collision_data != NULL);
-  collision_data->colliding = colliding;
-  collision_data->collision_handler = handler;
-  collision_data->aux = aux;
-  collision_data->freer = freer;
-  collision_data->body1 = body1;
-  collision_data->body2 = body2;
-  return collision_data;
+ForceData *force_data_init(Scalar force_constant, Body *body1, Body *body2){
+  if(force_data_pool == NULL){
+    force_data_pool = pool_init("ForceData", sizeof(ForceData), FORCES_POOL_BLOCK);
+  }
+  ForceData *force_data = pool_alloc(force_data_pool);
+  force_data->force_constant = force_constant;
+  force_data->body1 = body_get_handle(body1);
+  force_data->body2 = body_get_handle(body2);
+  return force_data;
 }
 
-void collision_data_free(CollisionData* data){
-  if(data->freer != NULL){
-    data->freer(data->aux);
-  }
-  free(data);
+void force_data_free(ForceData *data){
+  pool_release(force_data_pool, data);
 }
 
 // A ForceCreator that calculates the gravitational force between 2 bodies
 void calculate_g(ForceData *data){
-  Body *body1 = data->body1;
-  Body *body2 = data->body2;
-  double g = data->force_constant;
+  Body *body1 = body_from_handle(data->body1);
+  Body *body2 = body_from_handle(data->body2);
+  if(body1 == NULL || body2 == NULL){
+    return;
+  }
+  Scalar g = data->force_constant;
   Vector dist_vec = vec_subtract(body_get_centroid(body1), body_get_centroid(body2));
-  double dist = vec_magnitude(dist_vec);
+  Scalar dist = vec_magnitude(dist_vec);
   Vector unit_vec = vec_multiply(1.0 / dist, dist_vec);
-  double m1 = body_get_mass(body1);
-  double m2 = body_get_mass(body2);
-  double force_mag = g * m1 * m2 / pow(dist, 2.0);
+  Scalar m1 = body_get_mass(body1);
+  Scalar m2 = body_get_mass(body2);
+  Scalar force_mag = g * m1 * m2 / pow(dist, 2.0);
   // Force from body 1 to body 2
   Vector force = vec_multiply(force_mag, unit_vec);
   if(dist > MIN_DISTANCE){
@@ -83,13 +88,16 @@ void calculate_g(ForceData *data){
 // A ForceCreator that calculates the spring force using Hooke's Law between
 // 2 bodies
 void calculate_k(ForceData *data){
-  Body *body1 = data->body1;
-  Body *body2 = data->body2;
-  double k = data->force_constant;
+  Body *body1 = body_from_handle(data->body1);
+  Body *body2 = body_from_handle(data->body2);
+  if(body1 == NULL || body2 == NULL){
+    return;
+  }
+  Scalar k = data->force_constant;
   Vector dist_vec = vec_subtract(body_get_centroid(body1), body_get_centroid(body2));
-  double dist = vec_magnitude(dist_vec);
+  Scalar dist = vec_magnitude(dist_vec);
   Vector unit_vec = vec_multiply(1.0 / dist, dist_vec);
-  double force_mag = k * dist;
+  Scalar force_mag = k * dist;
   // Force from body 1 to body 2
   Vector force = vec_multiply(force_mag, unit_vec);
   body_add_force(body1, vec_negate(force));
@@ -98,46 +106,41 @@ void calculate_k(ForceData *data){
 
 // A ForceFunction that calculates the drag froce on a body using F= -gamma * v
 void calculate_gamma(ForceData *data){
-  Body *body = data->body1;
-  double gamma = data->force_constant;
+  Body *body = body_from_handle(data->body1);
+  if(body == NULL){
+    return;
+  }
+  Scalar gamma = data->force_constant;
   // Force from body 1 to body 2
   Vector force = vec_negate(vec_multiply(gamma, body_get_velocity(body)));
   body_add_force(body, force);
 }
 
-void create_newtonian_gravity(Scene *scene, double G, Body *body1, Body *body2){
+void create_newtonian_gravity(Scene *scene, Scalar G, Body *body1, Body *body2){
   ForceData *data = force_data_init(G, body1, body2);
-  List *bodies_affected = list_init(2, NULL);
-  list_add(bodies_affected, body1);
-  list_add(bodies_affected, body2);
-  scene_add_bodies_force_creator(scene, (ForceCreator) calculate_g, data, bodies_affected, free);
+  scene_add_pair_force_creator(scene, (ForceCreator) calculate_g, data, body1, body2, (FreeFunc) force_data_free);
 }
 
-void create_spring(Scene *scene, double k, Body *body1, Body *body2){
+void create_spring(Scene *scene, Scalar k, Body *body1, Body *body2){
   ForceData *data = force_data_init(k, body1, body2);
-  List *bodies_affected = list_init(2, NULL);
-  list_add(bodies_affected, body1);
-  list_add(bodies_affected, body2);
-  scene_add_bodies_force_creator(scene, (ForceCreator) calculate_k, data, bodies_affected, free);
+  scene_add_pair_force_creator(scene, (ForceCreator) calculate_k, data, body1, body2, (FreeFunc) force_data_free);
 }
 
-void create_drag(Scene *scene, double gamma, Body *body) {
+void create_drag(Scene *scene, Scalar gamma, Body *body) {
   ForceData *data = force_data_init(gamma, body, NULL);
-  List *bodies_affected = list_init(1, NULL);
-  list_add(bodies_affected, body);
-  scene_add_bodies_force_creator(scene, (ForceCreator) calculate_gamma, data, bodies_affected, free);
+  scene_add_pair_force_creator(scene, (ForceCreator) calculate_gamma, data, body, NULL, (FreeFunc) force_data_free);
 }
 
 //Collision handlers
 void repel_body(Body* body1, Body* body2, Vector axis, void* aux){
     PartialData *partial_data = (PartialData*) aux;
-    double elasticity = partial_data->elasticity;
+    Scalar elasticity = partial_data->elasticity;
     bool partial = partial_data->partial;
-    double reduced_mass;
-    double m1 = body_get_mass(body1);
-    double m2 = body_get_mass(body2);
-    double u_a = vec_dot(body_get_velocity(body1), axis);
-    double u_b = vec_dot(body_get_velocity(body2), axis);
+    Scalar reduced_mass;
+    Scalar m1 = body_get_mass(body1);
+    Scalar m2 = body_get_mass(body2);
+    Scalar u_a = vec_dot(body_get_velocity(body1), axis);
+    Scalar u_b = vec_dot(body_get_velocity(body2), axis);
     if(m1 == INFINITY){
       reduced_mass = m2;
     }
@@ -147,7 +150,7 @@ void repel_body(Body* body1, Body* body2, Vector axis, void* aux){
     else {
       reduced_mass = (m1 * m2) / (m1 + m2);
     }
-    double j_n = reduced_mass * (1 + elasticity) * (u_b - u_a);
+    Scalar j_n = reduced_mass * (1 + elasticity) * (u_b - u_a);
     Vector impulse = vec_multiply(j_n, axis);
     if(DEBUG)
     {
@@ -217,43 +220,46 @@ void destroy_body(Body* body1, Body* body2, Vector axis, void* aux){
   body_remove(body2);
 }
 
-void calculate_collision(CollisionData* data){
-  Body *body1 = data->body1;
-  Body *body2 = data->body2;
-  CollisionInfo info = find_collision(body_get_shape(body1), body_get_shape(body2));
-  if(info.collided && !data->colliding){
-    data->collision_handler(body1, body2, info.axis, data->aux);
-    data->colliding = true;
-  }
-  else{
-    data->colliding = false;
+void collision_respond(Body *body1, Body *body2, CollisionInfo info,
+    ContactEvent event, CollisionHandler handler, void *aux){
+  if(event == CONTACT_ENTER){
+    handler(body1, body2, info.axis, aux);
   }
 }
 
 void create_collision(Scene *scene, Body *body1, Body *body2,
 CollisionHandler handler, void *aux, FreeFunc freer){
-  CollisionData *data = collision_data_init(handler, aux, false, freer, body1, body2);
-  List *bodies_affected = list_init(2, NULL);
-  list_add(bodies_affected, body1);
-  list_add(bodies_affected, body2);
-  scene_add_bodies_force_creator(scene, (ForceCreator) calculate_collision, data, bodies_affected, (FreeFunc) collision_data_free);
+  scene_add_pair_collision(scene, body1, body2, collision_respond, handler, aux, freer);
+}
+
+void create_category_collision(Scene *scene, size_t category1, size_t category2,
+    CollisionHandler handler, void *aux, FreeFunc freer){
+  scene_add_category_collision(scene, category1, category2,
+    collision_respond, handler, aux, freer);
+}
+
+void create_category_physics_collision(Scene *scene, Scalar elasticity,
+    size_t category1, size_t category2){
+  PartialData *partial = partial_data_init(elasticity, false);
+  create_category_collision(scene, category1, category2, (CollisionHandler) repel_body,
+    (void*) partial, (FreeFunc) partial_data_free);
 }
 
 void create_destructive_collision(Scene *scene, Body *body1, Body *body2) {
   create_collision(scene, body1, body2, (CollisionHandler) destroy_body, NULL, NULL);
 }
 
-void create_partial_collision(Scene *scene, double elasticity, Body *body, Body *target){
+void create_partial_collision(Scene *scene, Scalar elasticity, Body *body, Body *target){
   PartialData *partial = partial_data_init(elasticity, true);
-  create_collision(scene, body, target, (CollisionHandler) repel_body, (void*) partial, free);
+  create_collision(scene, body, target, (CollisionHandler) repel_body, (void*) partial, (FreeFunc) partial_data_free);
 }
 
-void create_physics_collision(Scene *scene, double elasticity, Body *body1, Body *body2){
+void create_physics_collision(Scene *scene, Scalar elasticity, Body *body1, Body *body2){
   PartialData *partial = partial_data_init(elasticity, false);
-  create_collision(scene, body1, body2, (CollisionHandler) repel_body, (void*) partial, free);
+  create_collision(scene, body1, body2, (CollisionHandler) repel_body, (void*) partial, (FreeFunc) partial_data_free);
 }
 
 void create_partial_destructive_collision(Scene *scene, Body *object, Body *target){
   PartialData *partial = partial_data_init(0.0, true);
-  create_collision(scene, object, target, (CollisionHandler) destroy_body, (void*) partial, free);
+  create_collision(scene, object, target, (CollisionHandler) destroy_body, (void*) partial, (FreeFunc) partial_data_free);
 }
@@ -6,12 +6,33 @@
 #include <math.h>
 
 #define G_CONSTANT 9.8E3 // N m^2 / kg^2
-const double MIN_COLLISION_DISTANCE = 10;
+const Scalar MIN_COLLISION_DISTANCE = 10;
+
+bool body_is_on_platform(Body *body){
+  size_t count;
+  Contact *contacts = body_get_contacts(body, &count);
+  for(size_t i = 0; i < count; i++){
+    Body *other = body_from_handle(contacts[i].other);
+    if(other == NULL || contacts[i].normal.y > -BODY_GROUNDED_MIN_SLOPE){
+      continue;
+    }
+    size_t category = body_get_category(other);
+    if(category == PLATFORM || category == PLATFORM_TRIGGER){
+      return true;
+    }
+  }
+  return false;
+}
+
 void calculate_g_collision(ForceData *data){
-  Body *player = data->body1;
-  double g = data->force_constant;
-  BodyInfo* player_info = body_get_info(player);
-  if(!body_info_get_collision(player_info)){
+  Body *player = body_from_handle(data->body1);
+  if(player == NULL){
+    return;
+  }
+  Scalar g = data->force_constant;
+  // Only platforms hold the player up; points, powerups and hazards it
+  // lands on do not
+  if(!body_is_on_platform(player)){
     Vector force = (Vector){0, g};
     body_add_force(player, vec_negate(force));
   }
@@ -19,12 +40,12 @@ void calculate_g_collision(ForceData *data){
 
 void repel_player(Body* body1, Body* body2, Vector axis, void* aux){
     PartialData *partial_data = (PartialData*) aux;
-    double elasticity = partial_data->elasticity;
-    double reduced_mass;
-    double m1 = body_get_mass(body1);
-    double m2 = body_get_mass(body2);
-    double u_a = vec_dot(body_get_velocity(body1), axis);
-    double u_b = vec_dot(body_get_velocity(body2), axis);
+    Scalar elasticity = partial_data->elasticity;
+    Scalar reduced_mass;
+    Scalar m1 = body_get_mass(body1);
+    Scalar m2 = body_get_mass(body2);
+    Scalar u_a = vec_dot(body_get_velocity(body1), axis);
+    Scalar u_b = vec_dot(body_get_velocity(body2), axis);
     if(m1 == INFINITY){
       reduced_mass = m2;
     }
@@ -34,7 +55,7 @@ void repel_player(Body* body1, Body* body2, Vector axis, void* aux){
     else {
       reduced_mass = (m1 * m2) / (m1 + m2);
     }
-    double j_n = reduced_mass * (1 + elasticity) * (u_b - u_a);
+    Scalar j_n = reduced_mass * (1 + elasticity) * (u_b - u_a);
     Vector impulse = vec_multiply(j_n, axis);
     if(isnan(impulse.x) || impulse.y){
       impulse.x = 0;
@@ -46,22 +67,20 @@ void repel_player(Body* body1, Body* body2, Vector axis, void* aux){
 
 void create_gravity(Scene *scene, Body *player){
   ForceData *data = force_data_init(G_CONSTANT, player, NULL);
-  List *bodies_affected = list_init(1, NULL);
-  list_add(bodies_affected, player);
-  scene_add_bodies_force_creator(scene, (ForceCreator) calculate_g_collision, data, bodies_affected, free);
+  scene_add_pair_force_creator(scene, (ForceCreator) calculate_g_collision, data, player, NULL, (FreeFunc) force_data_free);
 }
 
 //NOTE: body2 is the Body being taken into consideration for lives
 void repel_body_with_life(Body* body1, Body* body2, Vector axis, void* aux){
     PartialData* partial_data = (PartialData*) aux;
-    double elasticity = partial_data->elasticity;
+    Scalar elasticity = partial_data->elasticity;
     bool partial = partial_data->partial;
     BodyInfo *info = body_get_info(body2);
-    double reduced_mass;
-    double m1 = body_get_mass(body1);
-    double m2 = body_get_mass(body2);
-    double u_a = vec_dot(body_get_velocity(body1), axis);
-    double u_b = vec_dot(body_get_velocity(body2), axis);
+    Scalar reduced_mass;
+    Scalar m1 = body_get_mass(body1);
+    Scalar m2 = body_get_mass(body2);
+    Scalar u_a = vec_dot(body_get_velocity(body1), axis);
+    Scalar u_b = vec_dot(body_get_velocity(body2), axis);
     if(m1 == INFINITY){
       reduced_mass = m2;
     }
@@ -71,7 +90,7 @@ void repel_body_with_life(Body* body1, Body* body2, Vector axis, void* aux){
     else {
       reduced_mass = (m1 * m2) / (m1 + m2);
     }
-    double j_n = reduced_mass * (1 + elasticity) * (u_b - u_a);
+    Scalar j_n = reduced_mass * (1 + elasticity) * (u_b - u_a);
     Vector impulse = vec_multiply(j_n, axis);
     if(isnan(impulse.x) || isnan(impulse.y)){
       impulse.x = 0;
@@ -120,46 +139,53 @@ void destroy_body_with_life(Body* body1, Body* body2, Vector axis, void* aux){
 
 
 
-void calculate_special_collision(CollisionData* data){
-  Body *player = data->body1;
-  Body *platform = data->body2;
-  BodyInfo* player_info = body_get_info(player);
-  BodyInfo* platform_info = body_get_info(platform);
-  double distance = (body_get_centroid(player).y + 5 - body_get_radius(player)) -
+// Calls the handler while the player touches the platform from close above it.
+// Unlike collision_respond(), this also runs on every tick the bodies stay in
+// contact: a player that first touches a platform from the side or from
+// further inside only comes within MIN_COLLISION_DISTANCE of its top some
+// ticks later, and must still be attached then. The handler must therefore
+// be safe to call repeatedly, as attach_body() is once the player moves with
+// the platform.
+void special_collision_respond(Body *player, Body *platform, CollisionInfo info,
+    ContactEvent event, CollisionHandler handler, void *aux){
+  Scalar distance = (body_get_centroid(player).y + 5 - body_get_radius(player)) -
   (body_get_centroid(platform).y + body_get_radius(platform));
-  CollisionInfo info = find_collision(body_get_shape(player), body_get_shape(platform));
-  if(info.collided && !body_info_get_collision(player_info) && !body_info_get_collision(platform_info) && fabs(distance) < MIN_COLLISION_DISTANCE){
-    body_info_set_collision(player_info, true);
-    body_info_set_collision(platform_info, true);
-    data->collision_handler(player, platform, info.axis, data->aux);
-  }
-  else if(body_info_get_collision(player_info) && body_info_get_collision(platform_info)){
-    body_info_set_collision(player_info, false);
-    body_info_set_collision(platform_info, false);
+  if(event != CONTACT_EXIT && fabs(distance) < MIN_COLLISION_DISTANCE){
+    handler(player, platform, info.axis, aux);
   }
 }
 
 void create_special_collision(Scene *scene, Body *player, Body *platform,
 CollisionHandler handler, void *aux, FreeFunc freer){
-  CollisionData *data = collision_data_init(handler, aux, false, freer, player, platform);
-  List *bodies_affected = list_init(2, NULL);
-  list_add(bodies_affected, player);
-  list_add(bodies_affected, platform);
-  scene_add_bodies_force_creator(scene, (ForceCreator) calculate_special_collision, data, bodies_affected, (FreeFunc) collision_data_free);
+  scene_add_pair_collision(scene, player, platform, special_collision_respond, handler, aux, freer);
+}
+
+void create_category_special_collision(Scene *scene, BodyType player, BodyType platform,
+CollisionHandler handler, void *aux, FreeFunc freer){
+  scene_add_category_collision(scene, player, platform, special_collision_respond,
+    handler, aux, freer);
 }
 
 /* All Superstar game collisions will be implemented here*/
 //Target is the one being removed
-void create_partial_collision_with_life(Scene *scene, double elasticity, Body *body, Body *target){
+void create_partial_collision_with_life(Scene *scene, Scalar elasticity, Body *body, Body *target){
   PartialData *data = partial_data_init(elasticity, true);
-  create_collision(scene, body, target, (CollisionHandler) repel_body_with_life, (void*) data, free);
+  create_collision(scene, body, target, (CollisionHandler) repel_body_with_life, (void*) data, (FreeFunc) partial_data_free);
+}
+
+void create_category_partial_collision_with_life(Scene *scene, Scalar elasticity, BodyType body, BodyType target){
+  if(scene_has_category_collision(scene, body, target)){
+    return;
+  }
+  PartialData *data = partial_data_init(elasticity, true);
+  create_category_collision(scene, body, target, (CollisionHandler) repel_body_with_life, (void*) data, (FreeFunc) partial_data_free);
 }
 
 // Sets velocity of the player to the platform when it is slightly above the platform
 // and is colliding
 void attach_body(Body* player, Body* platform, Vector axis, void* aux) {
   Vector player_vel = body_get_velocity(player);
-  double distance = (body_get_centroid(player).y + 2 - body_get_radius(player)) -
+  Scalar distance = (body_get_centroid(player).y + 2 - body_get_radius(player)) -
   (body_get_centroid(platform).y + body_get_radius(platform));
   if(player_vel.y < 0 && fabs(distance) < MIN_COLLISION_DISTANCE){
     body_set_velocity(player, (Vector){player_vel.x, body_get_velocity(platform).y});
@@ -190,6 +216,14 @@ void create_player_platform_collision(Scene *scene, Body* player, Body* platform
   create_special_collision(scene, player, platform, (CollisionHandler) attach_body, NULL, NULL);
 }
 
+// Creates the collision of every PLAYER with every platform of a type
+void create_category_player_platform_collision(Scene *scene, BodyType platform){
+  if(scene_has_category_collision(scene, PLAYER, platform)){
+    return;
+  }
+  create_category_special_collision(scene, PLAYER, platform, (CollisionHandler) attach_body, NULL, NULL);
+}
+
 // In charge of handling player-point collisions, increment 1 to score in scene
 // when this happens
 void eat_point(Body* player, Body* point, Vector axis, void* aux){
@@ -203,13 +237,30 @@ void create_player_point_collision(Scene *scene, Body* player, Body* point){
   create_collision(scene, player, point, (CollisionHandler) eat_point, (void*) scene, NULL);
 }
 
+// Creates the collision of every PLAYER with every POINT
+void create_category_player_point_collision(Scene *scene){
+  if(scene_has_category_collision(scene, PLAYER, POINT)){
+    return;
+  }
+  create_category_collision(scene, PLAYER, POINT, (CollisionHandler) eat_point, (void*) scene, NULL);
+}
+
 // Creates player-gravity ball collision
-void create_player_gravity_collision(Scene *scene, double elasticity, Body* player, Body* grav_ball){
+void create_player_gravity_collision(Scene *scene, Scalar elasticity, Body* player, Body* grav_ball){
   PartialData *partial = partial_data_init(elasticity, false);
-  create_collision(scene, player, grav_ball, (CollisionHandler) repel_player, (void*) partial, free);
+  create_collision(scene, player, grav_ball, (CollisionHandler) repel_player, (void*) partial, (FreeFunc) partial_data_free);
 }
 // Creates partial destructive collision
 void create_partial_destructive_collision_with_life(Scene *scene, Body *object, Body *target){
   PartialData *data = partial_data_init(0.0, true);
-  create_collision(scene, object, target, (CollisionHandler) destroy_body_with_life, (void*) data, free);
+  create_collision(scene, object, target, (CollisionHandler) destroy_body_with_life, (void*) data, (FreeFunc) partial_data_free);
+}
+
+// Creates partial destructive collision between every body of two types
+void create_category_partial_destructive_collision_with_life(Scene *scene, BodyType object, BodyType target){
+  if(scene_has_category_collision(scene, object, target)){
+    return;
+  }
+  PartialData *data = partial_data_init(0.0, true);
+  create_category_collision(scene, object, target, (CollisionHandler) destroy_body_with_life, (void*) data, (FreeFunc) partial_data_free);
 }
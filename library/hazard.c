@@ -7,8 +7,8 @@
 
 // Constants:
 const Vector DEFAULT_HAZARD_VEL = (Vector){0, -10};
-const double HAZARD_RADIUS = 1;
-const double HAZARD_MASS = 5E14;
+const Scalar HAZARD_RADIUS = 1;
+const Scalar HAZARD_MASS = 5E14;
 // GRAV_COLOR and SPIKE_COLOR are both BLACK
 const RGBColor GRAV_COLOR = (RGBColor){0.0, 0.0, 0.0};
 const RGBColor SPIKE_COLOR = (RGBColor){0.0, 0.0, 0.0};
@@ -19,23 +19,19 @@ const RGBColor BAD_BALL_COLOR = (RGBColor){0.0, 0.5, 0.5};
 void spike_hazard_init(Vector position, Scene* scene) {
   Body* spike = spike_init(position, HAZARD_RADIUS, INFINITY, SPIKE_COLOR, INFINITY);
   scene_add_body(scene, spike);
-  for(size_t i = 0; i < scene_bodies(scene); i++){
-    Body* body = scene_get_body(scene, i);
-    BodyInfo* info = body_get_info(body);
-    BodyType type = body_info_get_type(info);
-    if(type == PLAYER){
-      create_partial_collision_with_life(scene, 1, spike, body);
-    }
-    if(type == PLATFORM || type == PLATFORM_TRIGGER){
-      create_partial_destructive_collision_with_life(scene, spike, body);
-    }
-  }
+  // Spikes collide by type, so only the first spike creates these
+  create_category_partial_collision_with_life(scene, 1, SPIKE, PLAYER);
+  create_category_partial_destructive_collision_with_life(scene, SPIKE, PLATFORM);
+  create_category_partial_destructive_collision_with_life(scene, SPIKE, PLATFORM_TRIGGER);
 }
 
 void gravity_hazard_init(Vector position, Scene* scene){
     Body* grav_body = gravity_ball_init(position, 5 * HAZARD_RADIUS, HAZARD_MASS, GRAV_COLOR, 1);
     body_set_velocity(grav_body, DEFAULT_HAZARD_VEL);
     scene_add_body(scene, grav_body);
+    create_category_partial_destructive_collision_with_life(scene, SPIKE, GRAVITY_BALL);
+    // Gravity is a force rather than a collision, so each ball still pulls
+    // on each player by itself
     for(size_t i = 0; i < scene_bodies(scene); i++){
       Body* body = scene_get_body(scene, i);
       BodyInfo* info = body_get_info(body);
@@ -44,34 +40,25 @@ void gravity_hazard_init(Vector position, Scene* scene){
         create_newtonian_gravity(scene, G, grav_body, body);
         //create_player_gravity_collision(scene, 1, body, grav_body);
       }
-      if(type == SPIKE){
-        create_partial_destructive_collision_with_life(scene, body, grav_body);
-      }
     }
 }
 
 
-void moving_ball_hazard_init(Vector position, Vector velocity, double mass, Scene* scene){
+void moving_ball_hazard_init(Vector position, Vector velocity, Scalar mass, Scene* scene){
     Body* moving_ball_body = moving_ball_init(position, 5 * HAZARD_RADIUS, mass, BAD_BALL_COLOR, 1);
     body_set_velocity(moving_ball_body, velocity);
     scene_add_body(scene, moving_ball_body);
-    for(size_t i = 0; i < scene_bodies(scene); i++){
-      Body* body = scene_get_body(scene, i);
-      BodyInfo* info = body_get_info(body);
-      BodyType type = body_info_get_type(info);
-      if(type == PLAYER){
-        //Moving Ball and Player collision type
-        create_physics_collision(scene, 0.5, moving_ball_body, body);
-      }
-      if(type == SPIKE || type == BOUND){
-        create_partial_destructive_collision_with_life(scene, body, moving_ball_body);
-      }
+    //Moving Ball and Player collision type
+    if(!scene_has_category_collision(scene, MOVING_BALL, PLAYER)){
+      create_category_physics_collision(scene, 0.5, MOVING_BALL, PLAYER);
     }
+    create_category_partial_destructive_collision_with_life(scene, SPIKE, MOVING_BALL);
+    create_category_partial_destructive_collision_with_life(scene, BOUND, MOVING_BALL);
 }
 
 
 /*
-void spring_platforms_hazard_init(Vector position1, Vector position2, Vector dimension, double k, Scene* scene){
+void spring_platforms_hazard_init(Vector position1, Vector position2, Vector dimension, Scalar k, Scene* scene){
     Body* spring_platform_body1 = platform_spring_init(position1, dimension);
     Body* spring_platform_body2 = platform_spring_init(position2, dimension);
     scene_add_body(spring_platform_body1, scene);
@@ -54,6 +54,53 @@ void *list_remove(List *list, size_t index){
   return removed;
 }
 
+void *list_swap_remove(List *list, size_t index){
+  void *removed = list_get(list, index);
+  list->data[index] = list->data[list_size(list) - 1];
+  list->size--;
+  return removed;
+}
+
+size_t list_remove_if(List *list, ListPredicate should_remove, FreeFunc freer,
+  bool preserve_order) {
+  size_t old_size = list_size(list);
+  if(preserve_order) {
+    // Slide every kept element down over the holes left by removed ones
+    size_t kept = 0;
+    for(size_t i = 0; i < old_size; i++){
+      void *value = list->data[i];
+      if(should_remove(value)){
+        if(freer != NULL){
+          freer(value);
+        }
+      }
+      else {
+        list->data[kept] = value;
+        kept++;
+      }
+    }
+    list->size = kept;
+  }
+  else {
+    // Fill each hole with the last element, which is checked on the next pass
+    size_t i = 0;
+    while(i < list_size(list)){
+      void *value = list->data[i];
+      if(should_remove(value)){
+        if(freer != NULL){
+          freer(value);
+        }
+        list->data[i] = list->data[list_size(list) - 1];
+        list->size--;
+      }
+      else {
+        i++;
+      }
+    }
+  }
+  return old_size - list_size(list);
+}
+
 /** Checks the current capacity of List and shows whether it is full.
  * Returns 0 if false.
  * Returns 1 if true.
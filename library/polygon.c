@@ -2,17 +2,89 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "../include/polygon.h"
+#include "../include/simd.h"
+#include "../include/transform.h"
+#include "../include/arena.h"
 #include <math.h>
 
-double polygon_area(List *polygon) {
-  size_t size = list_size(polygon);
-  double area = 0;
+struct polygon {
+  Vector *vertices;
+  size_t capacity;
+  size_t size;
+};
+
+const size_t POLYGON_GROWTH_FACTOR = 2;
+
+Polygon *polygon_init(size_t initial_size) {
+  Polygon *polygon = malloc(sizeof(Polygon));
+  assert(polygon != NULL);
+  // Always keep room for at least one vertex so that resizing can grow
+  if(initial_size == 0) {
+    initial_size = 1;
+  }
+  polygon->capacity = initial_size;
+  polygon->size = 0;
+  polygon->vertices = malloc(initial_size * sizeof(Vector));
+  assert(polygon->vertices != NULL);
+  return polygon;
+}
+
+void polygon_free(Polygon *polygon) {
+  free(polygon->vertices);
+  free(polygon);
+}
+
+size_t polygon_size(Polygon *polygon) {
+  return polygon->size;
+}
+
+Vector polygon_get(Polygon *polygon, size_t index) {
+  assert(index < polygon_size(polygon));
+  return polygon->vertices[index];
+}
+
+void polygon_set(Polygon *polygon, size_t index, Vector vertex) {
+  assert(index < polygon_size(polygon));
+  polygon->vertices[index] = vertex;
+}
+
+void polygon_add(Polygon *polygon, Vector vertex) {
+  if(polygon->size == polygon->capacity) {
+    polygon->capacity = polygon->capacity * POLYGON_GROWTH_FACTOR;
+    polygon->vertices = realloc(polygon->vertices, polygon->capacity * sizeof(Vector));
+    assert(polygon->vertices != NULL);
+  }
+  polygon->vertices[polygon->size] = vertex;
+  polygon->size++;
+}
+
+Vector *polygon_vertices(Polygon *polygon) {
+  return polygon->vertices;
+}
+
+Polygon *polygon_copy(Polygon *polygon) {
+  Polygon *copy = polygon_init(polygon->size);
+  for(size_t i = 0; i < polygon->size; i++) {
+    copy->vertices[i] = polygon->vertices[i];
+  }
+  copy->size = polygon->size;
+  return copy;
+}
+
+Scalar polygon_area(Polygon *polygon) {
+  size_t size = polygon_size(polygon);
+  Vector *vertices = polygon_vertices(polygon);
+  Scalar area = 0;
 
   // Applies the area formula to every pair of vertices except the last
-  // and first one
+  // and first one.
+  // The vertices are taken relative to the first one, which gives the same
+  // area but keeps the cross products small for polygons far from the origin,
+  // so they do not lose precision (especially with float Scalars).
+  Vector origin = vertices[0];
   for(size_t i = 0; i < size; i++) {
-    Vector v1 = *(Vector*)list_get(polygon, i % size);
-    Vector v2 = *(Vector*)list_get(polygon, (i+1) % size);
+    Vector v1 = vec_subtract(vertices[i], origin);
+    Vector v2 = vec_subtract(vertices[(i+1) % size], origin);
     area = area + vec_cross(v1, v2);
   }
 
@@ -21,24 +93,26 @@ double polygon_area(List *polygon) {
   return area;
 }
 
-Vector polygon_centroid(List *polygon) {
-  size_t size = list_size(polygon);
-  double area = polygon_area(polygon);
-  double sum_x = 0, sum_y = 0, cx, cy;
+Vector polygon_centroid(Polygon *polygon) {
+  size_t size = polygon_size(polygon);
+  Vector *vertices = polygon_vertices(polygon);
+  Scalar area = polygon_area(polygon);
+  Scalar sum_x = 0, sum_y = 0, cx, cy;
 
   // Applies the centroid formula to every pair of vertices except the last
-  // and first one
+  // and first one, relative to the first vertex like polygon_area()
+  Vector origin = vertices[0];
   for(size_t i = 0; i < size; i++) {
-    Vector v1 = *(Vector*)list_get(polygon, i % size);
-    Vector v2 = *(Vector*)list_get(polygon, (i+1) % size);
-    double cross_product = vec_cross(v1, v2);
+    Vector v1 = vec_subtract(vertices[i], origin);
+    Vector v2 = vec_subtract(vertices[(i+1) % size], origin);
+    Scalar cross_product = vec_cross(v1, v2);
     sum_x = sum_x + (v1.x + v2.x) * cross_product;
     sum_y = sum_y + (v1.y + v2.y) * cross_product;
   }
 
   // Calculates the coordinates for the cardiod
-  cx = (double) sum_x / (6 * area);
-  cy = (double) sum_y / (6 * area);
+  cx = (Scalar) sum_x / (6 * area) + origin.x;
+  cy = (Scalar) sum_y / (6 * area) + origin.y;
 
   Vector centroid = {
     .x = cx,
@@ -48,25 +122,149 @@ Vector polygon_centroid(List *polygon) {
   return centroid;
 }
 
-void polygon_translate(List *polygon, Vector translation) {
+void polygon_translate(Polygon *polygon, Vector translation) {
   // Set the every vector in the data to be the original vector
   // translated by the translation vector
-  for(size_t i = 0; i < list_size(polygon); i++){
-    // The new vector
-    Vector* ptr = list_get(polygon, i);
-    *ptr = vec_add(*ptr, translation);
+  simd_translate(polygon->vertices, polygon->size, translation);
+}
+
+void polygon_rotate(Polygon *polygon, Scalar angle, Vector point) {
+  // Rotates every vertex around the given point in a single pass,
+  // computing the trig functions only once
+  polygon_transform(polygon, transform_rotation(angle, point));
+}
+
+void polygon_transform(Polygon *polygon, Transform2D transform) {
+  transform_apply_array(transform, polygon->vertices, polygon->size);
+}
+
+void polygon_copy_transformed(Polygon *destination, Polygon *source, Transform2D transform) {
+  if(destination->capacity < source->size) {
+    destination->capacity = source->size;
+    destination->vertices = realloc(destination->vertices, destination->capacity * sizeof(Vector));
+    assert(destination->vertices != NULL);
   }
+  destination->size = source->size;
+  simd_transform(source->vertices, destination->vertices, source->size,
+    transform.cos_angle, transform.sin_angle, transform.translation);
 }
 
-void polygon_rotate(List *polygon, double angle, Vector point) {
-  // We will translate all the current vertices by the inverse of the given point,
-  // so that we can rotate all our vertices around the origin (0, 0)
-  polygon_translate(polygon, vec_negate(point));
-  for(size_t i = 0; i < list_size(polygon); i++){
-    Vector* ptr = list_get(polygon, i);
-    *ptr = vec_rotate(*ptr, angle);
+size_t polygon_edge_normals(Polygon *polygon, Vector *normals) {
+  size_t size = polygon->size;
+  size_t count = 0;
+  for(size_t i = 0; i < size; i++) {
+    Vector edge = vec_subtract(polygon->vertices[(i + 1) % size], polygon->vertices[i]);
+    Scalar length = sqrt(vec_dot(edge, edge));
+    if(length == 0) {
+      continue;
+    }
+    Vector normal = {edge.y / length, -edge.x / length};
+    bool repeated = false;
+    for(size_t j = 0; j < count && !repeated; j++) {
+      repeated = fabs(vec_cross(normal, normals[j])) <= SCALAR_EPSILON;
+    }
+    if(!repeated) {
+      normals[count] = normal;
+      count++;
+    }
+  }
+  return count;
+}
+
+bool polygon_is_convex(Polygon *polygon) {
+  size_t size = polygon->size;
+  // Every corner must turn the same way; straight corners turn neither way
+  int turn = 0;
+  for(size_t i = 0; i < size; i++) {
+    Vector edge = vec_subtract(polygon->vertices[(i + 1) % size], polygon->vertices[i]);
+    Vector next = vec_subtract(polygon->vertices[(i + 2) % size], polygon->vertices[(i + 1) % size]);
+    Scalar cross = vec_cross(edge, next);
+    if(cross > 0 && turn < 0) {
+      return false;
+    }
+    if(cross < 0 && turn > 0) {
+      return false;
+    }
+    if(cross != 0) {
+      turn = cross > 0 ? 1 : -1;
+    }
+  }
+  return true;
+}
+
+// Returns the distance from a vertex to the line through its neighbours,
+// which is how far the outline moves if the vertex is dropped
+Scalar polygon_vertex_error(Vector previous, Vector vertex, Vector next) {
+  Vector chord = vec_subtract(next, previous);
+  Vector offset = vec_subtract(vertex, previous);
+  Scalar length = sqrt(vec_dot(chord, chord));
+  if(length == 0) {
+    return sqrt(vec_dot(offset, offset));
+  }
+  return fabs(vec_cross(chord, offset)) / length;
+}
+
+Polygon *polygon_simplify(Polygon *polygon, size_t min_size, Scalar tolerance) {
+  size_t size = polygon->size;
+  if(min_size < 3) {
+    min_size = 3;
+  }
+
+  // The kept vertices form a ring linked through previous and next
+  ArenaMark mark = arena_mark(frame_arena());
+  size_t *previous = frame_alloc(size * sizeof(size_t));
+  size_t *next = frame_alloc(size * sizeof(size_t));
+  bool *kept = frame_alloc(size * sizeof(bool));
+  for(size_t i = 0; i < size; i++) {
+    previous[i] = (i + size - 1) % size;
+    next[i] = (i + 1) % size;
+    kept[i] = true;
+  }
+
+  size_t remaining = size;
+  while(remaining > min_size) {
+    size_t best = 0;
+    Scalar best_error = INFINITY;
+    for(size_t i = 0; i < size; i++) {
+      if(kept[i]) {
+        Scalar error = polygon_vertex_error(polygon->vertices[previous[i]],
+          polygon->vertices[i], polygon->vertices[next[i]]);
+        if(error < best_error) {
+          best = i;
+          best_error = error;
+        }
+      }
+    }
+    if(best_error > tolerance) {
+      break;
+    }
+    kept[best] = false;
+    next[previous[best]] = next[best];
+    previous[next[best]] = previous[best];
+    remaining--;
+  }
+
+  Polygon *simplified = polygon_init(remaining);
+  for(size_t i = 0; i < size; i++) {
+    if(kept[i]) {
+      polygon_add(simplified, polygon->vertices[i]);
+    }
   }
-  // Now, we translate back all our vertices by the given point again to obtain
-  // our desired mutant polygon
-  polygon_translate(polygon, point);
+  arena_rewind(frame_arena(), mark);
+  return simplified;
+}
+
+AABB polygon_bounds(Polygon *polygon) {
+  AABB box;
+  simd_bounds(polygon->vertices, polygon->size, &box.min, &box.max);
+  return box;
+}
+
+AABB aabb_translate(AABB box, Vector translation) {
+  return (AABB){vec_add(box.min, translation), vec_add(box.max, translation)};
+}
+
+bool aabb_overlap(AABB box1, AABB box2) {
+  return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x &&
+    box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
 }
@@ -0,0 +1,161 @@
+#include "pool.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// When built with -fsanitize=address, released objects are poisoned so that
+// use-after-release is still reported even though the memory is never freed
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define POOL_USE_ASAN
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) && !defined(POOL_USE_ASAN)
+#define POOL_USE_ASAN
+#endif
+
+#ifdef POOL_USE_ASAN
+#include <sanitizer/asan_interface.h>
+#else
+#define ASAN_POISON_MEMORY_REGION(addr, size) ((void) (addr), (void) (size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void) (addr), (void) (size))
+#endif
+
+// Every object is aligned (and sized) to a multiple of this
+const size_t POOL_ALIGNMENT = 16;
+
+// Starts each block; the objects follow it
+typedef struct pool_block {
+  struct pool_block *next;
+} PoolBlock;
+
+// A released object, which holds the next link of the free list
+typedef struct pool_free_object {
+  struct pool_free_object *next;
+} PoolFreeObject;
+
+struct pool {
+  const char *name;
+  size_t object_size;
+  size_t block_size;
+  PoolBlock *blocks;
+  PoolFreeObject *free_list;
+  PoolStats stats;
+  Pool *next_registered;
+};
+
+/**
+ * Every pool that has been initialized and not yet freed.
+ */
+Pool *registered_pools = NULL;
+
+// Rounds size up to a multiple of POOL_ALIGNMENT
+size_t pool_round_up(size_t size) {
+  return (size + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT * POOL_ALIGNMENT;
+}
+
+Pool *pool_init(const char *name, size_t object_size, size_t block_size) {
+  assert(block_size > 0);
+  Pool *pool = malloc(sizeof(Pool));
+  assert(pool != NULL);
+  pool->name = name;
+  // Released objects must be able to hold a free list link
+  if(object_size < sizeof(PoolFreeObject)) {
+    object_size = sizeof(PoolFreeObject);
+  }
+  pool->object_size = pool_round_up(object_size);
+  pool->block_size = block_size;
+  pool->blocks = NULL;
+  pool->free_list = NULL;
+  pool->stats = (PoolStats){0, 0, 0, 0, 0};
+  pool->next_registered = registered_pools;
+  registered_pools = pool;
+  return pool;
+}
+
+void pool_free(Pool *pool) {
+  // Unregisters the pool
+  Pool **link = &registered_pools;
+  while(*link != pool) {
+    link = &(*link)->next_registered;
+  }
+  *link = pool->next_registered;
+
+  PoolBlock *block = pool->blocks;
+  while(block != NULL) {
+    PoolBlock *next = block->next;
+    ASAN_UNPOISON_MEMORY_REGION(block, pool_round_up(sizeof(PoolBlock)) + pool->object_size * pool->block_size);
+    free(block);
+    block = next;
+  }
+  free(pool);
+}
+
+// Allocates one more block and puts all of its objects on the free list
+void pool_grow(Pool *pool) {
+  size_t header_size = pool_round_up(sizeof(PoolBlock));
+  PoolBlock *block = malloc(header_size + pool->object_size * pool->block_size);
+  assert(block != NULL);
+  block->next = pool->blocks;
+  pool->blocks = block;
+
+  char *objects = (char *) block + header_size;
+  // Pushes in reverse so objects are handed out in address order
+  for(size_t i = pool->block_size; i > 0; i--) {
+    PoolFreeObject *object = (PoolFreeObject *) (objects + (i - 1) * pool->object_size);
+    object->next = pool->free_list;
+    pool->free_list = object;
+    ASAN_POISON_MEMORY_REGION(object, pool->object_size);
+  }
+  pool->stats.capacity += pool->block_size;
+  pool->stats.blocks++;
+}
+
+void *pool_alloc(Pool *pool) {
+  if(pool->free_list == NULL) {
+    pool_grow(pool);
+  }
+  PoolFreeObject *object = pool->free_list;
+  ASAN_UNPOISON_MEMORY_REGION(object, pool->object_size);
+  pool->free_list = object->next;
+
+  pool->stats.in_use++;
+  pool->stats.total_allocs++;
+  if(pool->stats.in_use > pool->stats.peak_in_use) {
+    pool->stats.peak_in_use = pool->stats.in_use;
+  }
+  return object;
+}
+
+void pool_release(Pool *pool, void *object) {
+  assert(pool->stats.in_use > 0);
+  PoolFreeObject *released = object;
+  released->next = pool->free_list;
+  pool->free_list = released;
+  pool->stats.in_use--;
+  ASAN_POISON_MEMORY_REGION(released, pool->object_size);
+}
+
+PoolStats pool_get_stats(Pool *pool) {
+  return pool->stats;
+}
+
+Pool *pool_find(const char *name) {
+  for(Pool *pool = registered_pools; pool != NULL; pool = pool->next_registered) {
+    if(strcmp(pool->name, name) == 0) {
+      return pool;
+    }
+  }
+  return NULL;
+}
+
+void pool_print_stats(void) {
+  for(Pool *pool = registered_pools; pool != NULL; pool = pool->next_registered) {
+    PoolStats stats = pool->stats;
+    printf("%-14s in use %6zu  peak %6zu  capacity %6zu  blocks %4zu  allocs %8zu\n",
+      pool->name, stats.in_use, stats.peak_in_use, stats.capacity,
+      stats.blocks, stats.total_allocs);
+  }
+}
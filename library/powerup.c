@@ -22,20 +22,21 @@ void activate_powerup(Body* player, Body* powerup, Vector axis, void* aux){
   body_remove(powerup);
 }
 
-Body *invincibility_init(Vector position, double radius, double mass, RGBColor color){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = POWERUP_INVINCIBILITY;
-  return star_init(5, position, radius, mass, color, 0, type);
+Body *invincibility_init(Vector position, Scalar radius, Scalar mass, RGBColor color){
+  return star_init(5, position, radius, mass, color, 0, POWERUP_INVINCIBILITY);
 }
 
-Body *expand_init(Vector position, double radius, double mass, RGBColor color){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = POWERUP_EXPAND;
-  return star_init(5, position, radius, mass, color, 0, type);
+Body *expand_init(Vector position, Scalar radius, Scalar mass, RGBColor color){
+  return star_init(5, position, radius, mass, color, 0, POWERUP_EXPAND);
 }
 
 void create_player_powerup_collision(Scene *scene, Body *player, Body *powerup){
   create_collision(scene, player, powerup, (CollisionHandler) activate_powerup, (void*) scene, NULL);
 }
+
+void create_category_player_powerup_collision(Scene *scene, BodyType powerup){
+  if(scene_has_category_collision(scene, PLAYER, powerup)){
+    return;
+  }
+  create_category_collision(scene, PLAYER, powerup, (CollisionHandler) activate_powerup, (void*) scene, NULL);
+}
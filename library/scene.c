@@ -4,22 +4,159 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "status.h"
+#include "pool.h"
+#include "collision.h"
+#include "aabb_tree.h"
+#include <math.h>
+#include <stdint.h>
 const size_t INITIAL_SIZE = 10;
+// The number of body pairs the pair table allocates space for at first
+const size_t SCENE_PAIRS_INITIAL = 64;
+// The number of body handles a scene_forcer stores without allocating
+#define SCENE_FORCER_INLINE_BODIES 2
 
 struct scene_forcer {
   ForceCreator forcer;
   void *aux;
   FreeFunc freer;
-  List* bodies_affected;
+  // Handles of the bodies the forcer acts on, copied from the List passed in.
+  // Points to inline_bodies unless there are more than fit there.
+  BodyHandle* bodies_affected;
+  size_t num_affected;
+  BodyHandle inline_bodies[SCENE_FORCER_INLINE_BODIES];
+  // Whether the forcer only checks its two bodies for a collision,
+  // so it can be skipped while their boxes are apart
+  bool collision;
+  // The last tick on which the broad phase found the bodies' boxes overlapping
+  size_t candidate_tick;
+  // The next collision forcer acting on the same pair of bodies
+  SceneForcer *next_in_pair;
 };
 
+// A collision between every body of one category and every body of another
+typedef struct scene_category_collision {
+  size_t category1;
+  size_t category2;
+  CollisionResponse response;
+  CollisionHandler handler;
+  void *aux;
+  FreeFunc freer;
+} SceneCategoryCollision;
+
+// A collision added for one pair of bodies with scene_add_pair_collision()
+typedef struct scene_pair_collision ScenePairCollision;
+struct scene_pair_collision {
+  CollisionResponse response;
+  CollisionHandler handler;
+  void *aux;
+  FreeFunc freer;
+  // The bodies in the order the response takes them
+  BodyHandle body1;
+  BodyHandle body2;
+  // The next collision added for the same pair
+  ScenePairCollision *next;
+};
+
+// A pair of bodies to check for collisions, in either order
+typedef struct scene_pair_key {
+  BodyHandle body1;
+  BodyHandle body2;
+} ScenePairKey;
+
+// Everything registered on one pair of bodies, which is tested at most once
+// per tick however many collisions share the result, keyed by the indices
+// of the bodies' handles, the smaller first
+typedef struct scene_pair {
+  size_t index1;
+  size_t index2;
+  // Whether the slot holds a pair
+  bool used;
+  // The bodies, the one with the smaller index first
+  BodyHandle body1;
+  BodyHandle body2;
+  // The collision forcers acting on the pair
+  SceneForcer *forcers;
+  // The collisions added for the pair
+  ScenePairCollision *collisions;
+  // Whether the bodies were touching on the last test, in which case each
+  // holds a contact with the other
+  bool touching;
+  // The axis that separated the bodies on the last test
+  SeparatingAxisCache separation;
+  // The last tick on which the pair was tested, or 0 if it never was
+  size_t checked_tick;
+} ScenePair;
+
+/**
+ * The pool every scene_forcer is allocated from, created on first use.
+ */
+Pool *scene_forcer_pool = NULL;
+// The number of scene_forcers the pool allocates space for at a time
+const size_t SCENE_FORCER_POOL_BLOCK = 256;
+
+/**
+ * The pool every scene_pair_collision is allocated from, created on first use.
+ */
+Pool *scene_pair_collision_pool = NULL;
+
 struct scene {
   List* bodies;
   List* scene_forcers;
   Status* status;
   size_t score;
+  // The number of ticks so far
+  size_t tick;
+  BroadPhase *broad_phase;
+  // The collision bounds of the dynamic bodies, refreshed at the start of
+  // each tick, the bodies' indices in the scene, and the indices of their
+  // handles, which the broad phase keeps track of them by
+  AABB *boxes;
+  size_t *dynamic_ids;
+  size_t *dynamic_keys;
+  size_t box_capacity;
+  // The static bodies (see scene_body_is_static()), in scene order, and
+  // their collision bounds when they were baked into static_tree.
+  // The tree is only rebuilt when this set or one of the boxes changes.
+  Body **statics;
+  AABB *static_boxes;
+  size_t static_count;
+  AABBTree *static_tree;
+  // The number of overlapping pairs found on the last tick
+  size_t broad_phase_pairs;
+  // An open-addressing hash table of the pairs of bodies with collision
+  // forcers or a category collision
+  ScenePair *pairs;
+  size_t pair_capacity;
+  size_t pair_count;
+  // The number of collisions added for pairs that were already tested for
+  // another, which share its test instead of repeating it
+  size_t duplicate_collisions;
+  // The category collisions, and for each pair of categories the one that
+  // applies to it, in both orders
+  List *category_collisions;
+  SceneCategoryCollision *category_matrix[SCENE_CATEGORIES][SCENE_CATEGORIES];
+  // For each category, a bit per category it collides with, so that most
+  // pairs the broad phase finds are passed over with one test
+  uint32_t category_masks[SCENE_CATEGORIES];
+  // The pairs category collisions are checked for on this tick, and those
+  // that were on the last tick, which are checked once more if they are not
+  // on this one
+  ScenePairKey *checks;
+  size_t check_count;
+  size_t check_capacity;
+  ScenePairKey *last_checks;
+  size_t last_check_count;
+  size_t last_check_capacity;
 };
 
+// Frees a category collision along with its auxiliary value
+void scene_category_collision_free(SceneCategoryCollision *collision){
+  if(collision->freer != NULL){
+    collision->freer(collision->aux);
+  }
+  free(collision);
+}
+
 Scene *scene_init(void) {
   Scene* scene = malloc(sizeof(Scene));
   assert(scene != NULL);
@@ -31,25 +168,109 @@ Scene *scene_init(void) {
   scene->scene_forcers = scene_forcers;
   scene->status = status_init();
   scene->score = 0;
+  scene->tick = 0;
+  scene->broad_phase = broad_phase_init(BROAD_PHASE_GRID);
+  scene->boxes = NULL;
+  scene->dynamic_ids = NULL;
+  scene->dynamic_keys = NULL;
+  scene->box_capacity = 0;
+  scene->statics = NULL;
+  scene->static_boxes = NULL;
+  scene->static_count = 0;
+  scene->static_tree = aabb_tree_init(0);
+  scene->broad_phase_pairs = 0;
+  scene->pairs = calloc(SCENE_PAIRS_INITIAL, sizeof(ScenePair));
+  assert(scene->pairs != NULL);
+  scene->pair_capacity = SCENE_PAIRS_INITIAL;
+  scene->pair_count = 0;
+  scene->duplicate_collisions = 0;
+  scene->category_collisions = list_init(INITIAL_SIZE,
+    (FreeFunc) scene_category_collision_free);
+  for(size_t i = 0; i < SCENE_CATEGORIES; i++){
+    for(size_t j = 0; j < SCENE_CATEGORIES; j++){
+      scene->category_matrix[i][j] = NULL;
+    }
+    scene->category_masks[i] = 0;
+  }
+  scene->checks = NULL;
+  scene->check_count = 0;
+  scene->check_capacity = 0;
+  scene->last_checks = NULL;
+  scene->last_check_count = 0;
+  scene->last_check_capacity = 0;
   return scene;
 }
 
-SceneForcer *scene_forcer_init(ForceCreator forcer, void *aux, FreeFunc freer, List* bodies_affected){
-  SceneForcer *scene_forcer = malloc(sizeof(SceneForcer));
+// Allocates a scene_forcer with room for num_affected body handles,
+// which the caller fills in
+SceneForcer *scene_forcer_alloc(ForceCreator forcer, void *aux, FreeFunc freer, size_t num_affected){
+  if(scene_forcer_pool == NULL){
+    scene_forcer_pool = pool_init("SceneForcer", sizeof(SceneForcer), SCENE_FORCER_POOL_BLOCK);
+  }
+  SceneForcer *scene_forcer = pool_alloc(scene_forcer_pool);
   scene_forcer->forcer = forcer;
   scene_forcer->aux = aux;
   scene_forcer->freer = freer;
-  scene_forcer->bodies_affected = bodies_affected;
+  scene_forcer->num_affected = num_affected;
+  scene_forcer->collision = false;
+  scene_forcer->candidate_tick = 0;
+  scene_forcer->next_in_pair = NULL;
+  if(num_affected <= SCENE_FORCER_INLINE_BODIES){
+    scene_forcer->bodies_affected = scene_forcer->inline_bodies;
+  }
+  else{
+    scene_forcer->bodies_affected = malloc(num_affected * sizeof(BodyHandle));
+    assert(scene_forcer->bodies_affected != NULL);
+  }
   return scene_forcer;
 }
 
-// Frees a single scene_forcer; the List of bodies_affected should
+// Takes ownership of bodies_affected, which is freed once its handles are copied
+SceneForcer *scene_forcer_init(ForceCreator forcer, void *aux, FreeFunc freer, List* bodies_affected){
+  size_t num_affected = bodies_affected == NULL ? 0 : list_size(bodies_affected);
+  SceneForcer *scene_forcer = scene_forcer_alloc(forcer, aux, freer, num_affected);
+  for(size_t i = 0; i < num_affected; i++){
+    scene_forcer->bodies_affected[i] = body_get_handle(list_get(bodies_affected, i));
+  }
+  if(bodies_affected != NULL){
+    list_free(bodies_affected);
+  }
+  return scene_forcer;
+}
+
+// Frees a single scene_forcer, without freeing the bodies it acts on
 void scene_forcer_single_free(SceneForcer* scene_forcer){
   if(scene_forcer->freer != NULL){
     scene_forcer->freer(scene_forcer->aux);
   }
-  list_free(scene_forcer->bodies_affected);
-  free(scene_forcer);
+  if(scene_forcer->bodies_affected != scene_forcer->inline_bodies){
+    free(scene_forcer->bodies_affected);
+  }
+  pool_release(scene_forcer_pool, scene_forcer);
+}
+
+// Returns whether any of the bodies a scene_forcer acts on has been removed,
+// in which case the scene_forcer must be removed as well.
+// Each check only compares handle generations, so no body is dereferenced.
+bool scene_forcer_is_removed(SceneForcer* scene_forcer){
+  for(size_t j = 0; j < scene_forcer->num_affected; j++){
+    if(!body_handle_is_live(scene_forcer->bodies_affected[j])){
+      return true;
+    }
+  }
+  return false;
+}
+
+// Frees a list of pair collisions along with their auxiliary values
+void scene_pair_collisions_free(ScenePairCollision *collision){
+  while(collision != NULL){
+    ScenePairCollision *next = collision->next;
+    if(collision->freer != NULL){
+      collision->freer(collision->aux);
+    }
+    pool_release(scene_pair_collision_pool, collision);
+    collision = next;
+  }
 }
 
 // THIS SHOULD NOT FREE ANY BODIES THAT ARE MARKED FOR REMOVAL
@@ -67,6 +288,22 @@ void scene_free(Scene *scene) {
   list_free(scene->scene_forcers);
   // Frees status board
   status_free(scene->status);
+  broad_phase_free(scene->broad_phase);
+  free(scene->boxes);
+  free(scene->dynamic_ids);
+  free(scene->dynamic_keys);
+  free(scene->statics);
+  free(scene->static_boxes);
+  aabb_tree_free(scene->static_tree);
+  for(size_t i = 0; i < scene->pair_capacity; i++){
+    if(scene->pairs[i].used){
+      scene_pair_collisions_free(scene->pairs[i].collisions);
+    }
+  }
+  free(scene->pairs);
+  list_free(scene->category_collisions);
+  free(scene->checks);
+  free(scene->last_checks);
   free(scene);
 }
 
@@ -109,6 +346,435 @@ void scene_add_bodies_force_creator(
   list_add(scene->scene_forcers, scene_forcer_init(forcer, aux, freer, bodies));
 }
 
+void scene_add_pair_force_creator(
+    Scene *scene, ForceCreator forcer, void *aux, Body *body1, Body *body2, FreeFunc freer
+){
+  size_t num_affected = body2 == NULL ? 1 : 2;
+  SceneForcer *scene_forcer = scene_forcer_alloc(forcer, aux, freer, num_affected);
+  scene_forcer->bodies_affected[0] = body_get_handle(body1);
+  if(body2 != NULL){
+    scene_forcer->bodies_affected[1] = body_get_handle(body2);
+  }
+  list_add(scene->scene_forcers, scene_forcer);
+}
+
+// Finds the slot of the pair table that holds a pair of handle indices,
+// or the empty slot where it would go
+ScenePair *scene_pair_slot(Scene *scene, size_t index1, size_t index2){
+  if(index1 > index2){
+    size_t swap = index1;
+    index1 = index2;
+    index2 = swap;
+  }
+  // The capacity is a power of 2, so masking takes the remainder
+  size_t mask = scene->pair_capacity - 1;
+  size_t slot = (index1 * 0x9E3779B97F4A7C15ULL ^ index2 * 0xC2B2AE3D27D4EB4FULL) & mask;
+  while(scene->pairs[slot].used &&
+    (scene->pairs[slot].index1 != index1 || scene->pairs[slot].index2 != index2)){
+    slot = (slot + 1) & mask;
+  }
+  scene->pairs[slot].index1 = index1;
+  scene->pairs[slot].index2 = index2;
+  return &scene->pairs[slot];
+}
+
+// Finds the slot of the pair table that holds a pair of bodies, filling in
+// an empty one if the pair is not in the table yet, which must have room for it
+ScenePair *scene_pair_claim(Scene *scene, BodyHandle body1, BodyHandle body2){
+  if(body1.index > body2.index){
+    BodyHandle swap = body1;
+    body1 = body2;
+    body2 = swap;
+  }
+  ScenePair *pair = scene_pair_slot(scene, body1.index, body2.index);
+  if(!pair->used){
+    pair->used = true;
+    pair->forcers = NULL;
+    pair->collisions = NULL;
+    scene->pair_count++;
+  }
+  else if(pair->body1.generation == body1.generation &&
+    pair->body2.generation == body2.generation){
+    return pair;
+  }
+  else{
+    // The pair was left by bodies that have since been freed
+    scene_pair_collisions_free(pair->collisions);
+    pair->collisions = NULL;
+  }
+  pair->body1 = body1;
+  pair->body2 = body2;
+  pair->touching = false;
+  pair->separation = SEPARATING_AXIS_CACHE_EMPTY;
+  pair->checked_tick = 0;
+  return pair;
+}
+
+// Adds a collision forcer to the pair table, which must have room for it
+void scene_pair_add(Scene *scene, SceneForcer *scene_forcer){
+  ScenePair *pair = scene_pair_claim(scene, scene_forcer->bodies_affected[0],
+    scene_forcer->bodies_affected[1]);
+  scene_forcer->next_in_pair = pair->forcers;
+  pair->forcers = scene_forcer;
+}
+
+// Ends the contact between a pair of bodies whose pair is being dropped,
+// without an exit event. The bodies have not been freed yet.
+void scene_pair_untouch(ScenePair *pair){
+  Body *body1 = body_from_handle(pair->body1);
+  Body *body2 = body_from_handle(pair->body2);
+  if(pair->touching && body1 != NULL && body2 != NULL){
+    body_clear_contact(body1, pair->body2);
+    body_clear_contact(body2, pair->body1);
+  }
+}
+
+// Refills the pair table with room for the given number of pairs from the
+// pairs with collisions or that have been tested, and from the scene's
+// collision forcers. If sweep is set, the pairs of removed bodies are
+// dropped and their collisions freed; otherwise every pair is kept, since a
+// collision may be responding to one as the table grows.
+void scene_pairs_rebuild(Scene *scene, size_t capacity, bool sweep){
+  ScenePair *old = scene->pairs;
+  size_t old_capacity = scene->pair_capacity;
+  scene->pairs = malloc(capacity * sizeof(ScenePair));
+  assert(scene->pairs != NULL);
+  scene->pair_capacity = capacity;
+  for(size_t i = 0; i < capacity; i++){
+    scene->pairs[i].used = false;
+  }
+  scene->pair_count = 0;
+  for(size_t i = 0; i < old_capacity; i++){
+    ScenePair *pair = &old[i];
+    if(!pair->used){
+      continue;
+    }
+    if(sweep && (!body_handle_is_live(pair->body1) || !body_handle_is_live(pair->body2))){
+      scene_pair_collisions_free(pair->collisions);
+      scene_pair_untouch(pair);
+    }
+    else if(pair->collisions != NULL || pair->checked_tick != 0){
+      ScenePair *kept = scene_pair_claim(scene, pair->body1, pair->body2);
+      *kept = *pair;
+      kept->forcers = NULL;
+    }
+  }
+  free(old);
+  for(size_t i = 0; i < list_size(scene->scene_forcers); i++){
+    SceneForcer *scene_forcer = list_get(scene->scene_forcers, i);
+    if(scene_forcer->collision){
+      scene_pair_add(scene, scene_forcer);
+    }
+  }
+}
+
+// Makes room in the pair table for one more pair, keeping it at most half
+// full so that probes stay short
+void scene_pairs_reserve(Scene *scene){
+  if(2 * (scene->pair_count + 1) > scene->pair_capacity){
+    scene_pairs_rebuild(scene, 2 * scene->pair_capacity, false);
+  }
+}
+
+void scene_add_collision_force_creator(
+    Scene *scene, ForceCreator forcer, void *aux, Body *body1, Body *body2, FreeFunc freer
+){
+  scene_add_pair_force_creator(scene, forcer, aux, body1, body2, freer);
+  SceneForcer *scene_forcer = list_get(scene->scene_forcers, list_size(scene->scene_forcers) - 1);
+  scene_forcer->collision = true;
+  scene_pairs_reserve(scene);
+  scene_pair_add(scene, scene_forcer);
+}
+
+void scene_add_pair_collision(Scene *scene, Body *body1, Body *body2,
+    CollisionResponse response, CollisionHandler handler, void *aux, FreeFunc freer){
+  if(scene_pair_collision_pool == NULL){
+    scene_pair_collision_pool = pool_init("ScenePairCollision", sizeof(ScenePairCollision),
+      SCENE_FORCER_POOL_BLOCK);
+  }
+  ScenePairCollision *collision = pool_alloc(scene_pair_collision_pool);
+  collision->response = response;
+  collision->handler = handler;
+  collision->aux = aux;
+  collision->freer = freer;
+  collision->body1 = body_get_handle(body1);
+  collision->body2 = body_get_handle(body2);
+  scene_pairs_reserve(scene);
+  ScenePair *pair = scene_pair_claim(scene, collision->body1, collision->body2);
+  if(pair->collisions != NULL || scene_has_category_collision(scene,
+    body_get_category(body1), body_get_category(body2))){
+    scene->duplicate_collisions++;
+  }
+  collision->next = pair->collisions;
+  pair->collisions = collision;
+}
+
+size_t scene_get_duplicate_collisions(Scene *scene){
+  return scene->duplicate_collisions;
+}
+
+void scene_add_category_collision(Scene *scene, size_t category1, size_t category2,
+    CollisionResponse response, CollisionHandler handler, void *aux, FreeFunc freer){
+  assert(category1 < SCENE_CATEGORIES && category2 < SCENE_CATEGORIES);
+  assert(!scene_has_category_collision(scene, category1, category2));
+  SceneCategoryCollision *collision = malloc(sizeof(SceneCategoryCollision));
+  assert(collision != NULL);
+  collision->category1 = category1;
+  collision->category2 = category2;
+  collision->response = response;
+  collision->handler = handler;
+  collision->aux = aux;
+  collision->freer = freer;
+  list_add(scene->category_collisions, collision);
+  scene->category_matrix[category1][category2] = collision;
+  scene->category_matrix[category2][category1] = collision;
+  scene->category_masks[category1] |= (uint32_t) 1 << category2;
+  scene->category_masks[category2] |= (uint32_t) 1 << category1;
+}
+
+bool scene_has_category_collision(Scene *scene, size_t category1, size_t category2){
+  return category1 < SCENE_CATEGORIES && category2 < SCENE_CATEGORIES &&
+    (scene->category_masks[category1] >> category2 & 1);
+}
+
+void scene_set_broad_phase(Scene *scene, BroadPhaseKind kind){
+  Scalar cell_size = broad_phase_get_cell_size(scene->broad_phase);
+  broad_phase_free(scene->broad_phase);
+  scene->broad_phase = broad_phase_init(kind);
+  broad_phase_set_cell_size(scene->broad_phase, cell_size);
+}
+
+BroadPhase *scene_get_broad_phase(Scene *scene){
+  return scene->broad_phase;
+}
+
+size_t scene_get_broad_phase_pairs(Scene *scene){
+  return scene->broad_phase_pairs;
+}
+
+// Adds a pair to the pairs checked for collisions this tick
+void scene_add_check(Scene *scene, BodyHandle body1, BodyHandle body2){
+  if(scene->check_count == scene->check_capacity){
+    scene->check_capacity = scene->check_capacity == 0 ? 64 : 2 * scene->check_capacity;
+    scene->checks = realloc(scene->checks, scene->check_capacity * sizeof(ScenePairKey));
+    assert(scene->checks != NULL);
+  }
+  scene->checks[scene->check_count] = (ScenePairKey){body1, body2};
+  scene->check_count++;
+}
+
+// Marks the collision forcers on a pair of bodies to run this tick, and the
+// pair to be checked if collisions were added for it or a category
+// collision applies to it
+void scene_mark_pair(Scene *scene, Body *body1, Body *body2){
+  ScenePair *pair = scene_pair_slot(scene, body_get_handle(body1).index,
+    body_get_handle(body2).index);
+  bool collisions = false;
+  if(pair->used){
+    for(SceneForcer *forcer = pair->forcers; forcer != NULL; forcer = forcer->next_in_pair){
+      forcer->candidate_tick = scene->tick;
+    }
+    collisions = pair->collisions != NULL;
+  }
+  scene->broad_phase_pairs++;
+  if(collisions || scene_has_category_collision(scene, body_get_category(body1),
+    body_get_category(body2))){
+    scene_add_check(scene, body_get_handle(body1), body_get_handle(body2));
+  }
+}
+
+// Marks a pair of dynamic bodies, given by their ids in the broad phase
+void scene_mark_dynamic_pair(size_t id1, size_t id2, Scene *scene){
+  scene_mark_pair(scene, scene_get_body(scene, scene->dynamic_ids[id1]),
+    scene_get_body(scene, scene->dynamic_ids[id2]));
+}
+
+// What the static tree is queried with for each dynamic body
+typedef struct static_query {
+  Scene *scene;
+  Body *body;
+} StaticQuery;
+
+// Marks a dynamic body and a static one, given by its id in the static tree
+void scene_mark_static_pair(size_t id, StaticQuery *query){
+  scene_mark_pair(query->scene, query->body, query->scene->statics[id]);
+}
+
+bool scene_body_is_static(Body *body){
+  Vector velocity = body_get_velocity(body);
+  return body_get_mass(body) == INFINITY && velocity.x == 0 && velocity.y == 0;
+}
+
+// Rebuilds the static tree from the static bodies' boxes
+void scene_bake_statics(Scene *scene){
+  aabb_tree_free(scene->static_tree);
+  scene->static_tree = aabb_tree_init(0);
+  for(size_t i = 0; i < scene->static_count; i++){
+    aabb_tree_insert(scene->static_tree, scene->static_boxes[i], i);
+  }
+}
+
+// Grows the arrays that hold a box or id per body to fit every body
+void scene_reserve_boxes(Scene *scene, size_t count){
+  if(scene->box_capacity >= count){
+    return;
+  }
+  scene->box_capacity = count * 2;
+  scene->boxes = realloc(scene->boxes, scene->box_capacity * sizeof(AABB));
+  scene->dynamic_ids = realloc(scene->dynamic_ids, scene->box_capacity * sizeof(size_t));
+  scene->dynamic_keys = realloc(scene->dynamic_keys, scene->box_capacity * sizeof(size_t));
+  scene->statics = realloc(scene->statics, scene->box_capacity * sizeof(Body *));
+  scene->static_boxes = realloc(scene->static_boxes, scene->box_capacity * sizeof(AABB));
+  assert(scene->boxes != NULL && scene->dynamic_ids != NULL && scene->dynamic_keys != NULL &&
+    scene->statics != NULL && scene->static_boxes != NULL);
+}
+
+// Splits the bodies into static and dynamic ones, rebaking the static tree
+// if the static ones have changed, then marks the pairs of dynamic bodies the
+// broad phase finds and the pairs of a dynamic body and a static one the
+// static tree finds. Pairs of static bodies are never checked.
+void scene_find_candidates(Scene *scene){
+  size_t count = scene_bodies(scene);
+  scene_reserve_boxes(scene, count);
+  size_t dynamic = 0;
+  size_t statics = 0;
+  bool changed = false;
+  for(size_t i = 0; i < count; i++){
+    Body *body = scene_get_body(scene, i);
+    AABB box = body_collision_bounds(body);
+    if(!scene_body_is_static(body)){
+      scene->boxes[dynamic] = box;
+      scene->dynamic_ids[dynamic] = i;
+      scene->dynamic_keys[dynamic] = body_get_handle(body).index;
+      dynamic++;
+      continue;
+    }
+    AABB *baked = &scene->static_boxes[statics];
+    if(statics >= scene->static_count || scene->statics[statics] != body ||
+      baked->min.x != box.min.x || baked->min.y != box.min.y ||
+      baked->max.x != box.max.x || baked->max.y != box.max.y){
+      changed = true;
+      scene->statics[statics] = body;
+      *baked = box;
+    }
+    statics++;
+  }
+  if(changed || statics != scene->static_count){
+    scene->static_count = statics;
+    scene_bake_statics(scene);
+  }
+
+  scene->broad_phase_pairs = 0;
+  scene->check_count = 0;
+  broad_phase_find_pairs(scene->broad_phase, scene->boxes, scene->dynamic_keys, dynamic,
+    (BroadPhasePairHandler) scene_mark_dynamic_pair, scene);
+  for(size_t i = 0; i < dynamic && statics > 0; i++){
+    StaticQuery query = {scene, scene_get_body(scene, scene->dynamic_ids[i])};
+    aabb_tree_query(scene->static_tree, scene->boxes[i],
+      (AABBTreeQueryHandler) scene_mark_static_pair, &query);
+  }
+}
+
+size_t scene_get_static_bodies(Scene *scene){
+  return scene->static_count;
+}
+
+// Returns whether a forcer has to run this tick: every forcer does, except
+// collision forcers whose bodies' boxes were apart on this tick and the last.
+// The extra tick lets a collision that just ended see that it has.
+bool scene_forcer_should_run(Scene *scene, SceneForcer *scene_forcer){
+  return !scene_forcer->collision || scene_forcer->candidate_tick + 1 >= scene->tick;
+}
+
+// Tests a pair of bodies for a collision, unless it has been tested on this
+// tick already, and passes the result to the category collision that applies
+// to the pair and to every collision added for it
+void scene_check_pair(Scene *scene, ScenePairKey key){
+  Body *body1 = body_from_handle(key.body1);
+  Body *body2 = body_from_handle(key.body2);
+  if(body1 == NULL || body2 == NULL){
+    return;
+  }
+  scene_pairs_reserve(scene);
+  ScenePair *pair = scene_pair_claim(scene, key.body1, key.body2);
+  if(pair->checked_tick == scene->tick){
+    return;
+  }
+  pair->checked_tick = scene->tick;
+  // Tests the bodies in the category collision's order if there is one,
+  // or else in the order of the last collision added
+  size_t category1 = body_get_category(body1);
+  size_t category2 = body_get_category(body2);
+  SceneCategoryCollision *category = NULL;
+  bool swap = false;
+  if(scene_has_category_collision(scene, category1, category2)){
+    category = scene->category_matrix[category1][category2];
+    swap = category->category1 != category1;
+  }
+  else if(pair->collisions != NULL){
+    swap = pair->collisions->body1.index != key.body1.index;
+  }
+  if(swap){
+    body1 = body_from_handle(key.body2);
+    body2 = body_from_handle(key.body1);
+  }
+  CollisionInfo info = find_body_collision_cached(body1, body2, &pair->separation,
+    NARROW_PHASE_AUTO);
+  CollisionInfo reversed = info;
+  reversed.axis = vec_negate(info.axis);
+
+  // Updates the contact graph, then lets the collisions respond to the change
+  ContactEvent event;
+  if(info.collided){
+    event = pair->touching ? CONTACT_STAY : CONTACT_ENTER;
+    body_set_contact(body1, body_get_handle(body2), info.axis);
+    body_set_contact(body2, body_get_handle(body1), reversed.axis);
+  }
+  else if(pair->touching){
+    event = CONTACT_EXIT;
+    body_clear_contact(body1, body_get_handle(body2));
+    body_clear_contact(body2, body_get_handle(body1));
+  }
+  else{
+    return;
+  }
+  pair->touching = info.collided;
+  // Responses may add pairs, which can move this one in the table, but not
+  // the collisions it points to
+  ScenePairCollision *collisions = pair->collisions;
+  if(category != NULL){
+    category->response(body1, body2, info, event, category->handler, category->aux);
+  }
+  for(ScenePairCollision *collision = collisions; collision != NULL; collision = collision->next){
+    if(collision->body1.index == body_get_handle(body1).index){
+      collision->response(body1, body2, info, event, collision->handler, collision->aux);
+    }
+    else{
+      collision->response(body2, body1, reversed, event, collision->handler, collision->aux);
+    }
+  }
+}
+
+// Checks the pairs of bodies with collisions whose boxes overlapped on this
+// tick or the last one. The extra tick lets a collision that just ended
+// see that it has.
+void scene_check_collisions(Scene *scene){
+  for(size_t i = 0; i < scene->check_count; i++){
+    scene_check_pair(scene, scene->checks[i]);
+  }
+  for(size_t i = 0; i < scene->last_check_count; i++){
+    scene_check_pair(scene, scene->last_checks[i]);
+  }
+  ScenePairKey *checks = scene->last_checks;
+  size_t capacity = scene->last_check_capacity;
+  scene->last_checks = scene->checks;
+  scene->last_check_count = scene->check_count;
+  scene->last_check_capacity = scene->check_capacity;
+  scene->checks = checks;
+  scene->check_count = 0;
+  scene->check_capacity = capacity;
+}
+
 void scene_add_force_creator(Scene *scene, ForceCreator forcer, void *aux, FreeFunc freer){
   scene_add_bodies_force_creator(scene, forcer, aux, NULL, freer);
 }
@@ -118,7 +784,7 @@ void scene_remove_body(Scene *scene, size_t index) {
   body_remove((Body*)list_get(scene->bodies, index));
 }
 
-void scene_background_tick(Scene * scene, double dt, Vector max)
+void scene_background_tick(Scene * scene, Scalar dt, Vector max)
 {
   for(size_t i = 0; i < scene_bodies(scene); i++){
     Body *body = scene_get_body(scene, i);
@@ -128,35 +794,35 @@ void scene_background_tick(Scene * scene, double dt, Vector max)
 }
 
 
-void scene_tick(Scene *scene, double dt) {
+void scene_tick(Scene *scene, Scalar dt) {
+  scene->tick++;
+  scene_find_candidates(scene);
   // Iterate over every force creator
   for(size_t i = 0; i < list_size(scene->scene_forcers); i++){
     SceneForcer* scene_forcer = (SceneForcer*) list_get(scene->scene_forcers, i);
-    scene_forcer->forcer(scene_forcer->aux);
-  }
-  for(size_t i = 0; i < list_size(scene->scene_forcers); i++){
-    SceneForcer* scene_forcer = (SceneForcer*) list_get(scene->scene_forcers, i);
-    List* affected = scene_forcer->bodies_affected;
-    // Checks if any of the affected bodies have been marked for removal. If yes,
-    // then set local variable to true to avoid calling scene_forcer onto
-    for(size_t j = 0; j < list_size(affected); j++){
-      if(body_is_removed((Body*)list_get(affected, j))){
-        scene_forcer_single_free(list_remove(scene->scene_forcers, i));
-        i--;
-        break;
-      }
+    if(scene_forcer_should_run(scene, scene_forcer)){
+      scene_forcer->forcer(scene_forcer->aux);
     }
   }
+  scene_check_collisions(scene);
+  size_t removed = 0;
   for(size_t i = 0; i < scene_bodies(scene); i++){
     Body *body = scene_get_body(scene, i);
     body_tick(body, dt);
-  }
-  for(size_t i = 0; i < scene_bodies(scene); i++){
-    Body *body = scene_get_body(scene, i);
     if(body_is_removed(body)){
-      body_free(list_remove(scene->bodies, i));
-      i--;
+      removed++;
     }
   }
+  // Nothing needs sweeping unless a body was removed this tick
+  if(removed > 0){
+    // Sweeps out the scene_forcers acting on removed bodies in a single pass.
+    // Their order does not matter, so holes are filled from the end.
+    list_remove_if(scene->scene_forcers, (ListPredicate) scene_forcer_is_removed,
+      (FreeFunc) scene_forcer_single_free, false);
+    scene_pairs_rebuild(scene, scene->pair_capacity, true);
+    // Bodies keep their order so that the player stays at index 0
+    list_remove_if(scene->bodies, (ListPredicate) body_is_removed,
+      (FreeFunc) body_free, true);
+  }
   status_tick(scene_get_status(scene));
 }
@@ -6,6 +6,8 @@
 #include <SDL2/SDL_ttf.h>
 #include <time.h>
 #include "sdl_wrapper.h"
+#include "arena.h"
+#include "shape.h"
 
 #define WINDOW_TITLE "CS 3"
 #define WINDOW_WIDTH 1000
@@ -84,12 +86,12 @@ void sdl_init(Vector min, Vector max) {
 }
 
 bool sdl_is_done(void) {
-    SDL_Event *event = malloc(sizeof(*event));
-    assert(event);
+    ArenaMark mark = arena_mark(frame_arena());
+    SDL_Event *event = frame_alloc(sizeof(*event));
     while (SDL_PollEvent(event)) {
         switch (event->type) {
             case SDL_QUIT:
-                free(event);
+                arena_rewind(frame_arena(), mark);
                 return true;
             case SDL_KEYDOWN:
             case SDL_KEYUP:
@@ -111,7 +113,7 @@ bool sdl_is_done(void) {
                 break;
         }
     }
-    free(event);
+    arena_rewind(frame_arena(), mark);
     return false;
 }
 
@@ -120,38 +122,42 @@ void sdl_clear(void) {
     SDL_RenderClear(renderer);
 }
 
-void sdl_draw_polygon(List *points, RGBColor color) {
+// Gets the size of the window and the scale that fits the scene in it
+double sdl_window_scale(int *width, int *height) {
+    SDL_GetWindowSize(window, width, height);
+    double x_scale = *width / 2.0 / max_diff.x,
+           y_scale = *height / 2.0 / max_diff.y;
+    return x_scale < y_scale ? x_scale : y_scale;
+}
+
+double sdl_get_scale(void) {
+    int width, height;
+    return sdl_window_scale(&width, &height);
+}
+
+// Draws a polygon placed by a transform in a window of the given size,
+// at the given scale
+void sdl_draw_polygon_scaled(Polygon *points, Transform2D transform, RGBColor color,
+    int width, int height, double scale) {
     // Check parameters
-    size_t n = list_size(points);
+    size_t n = polygon_size(points);
     assert(n >= 3);
     assert(0 <= color.r && color.r <= 1);
     assert(0 <= color.g && color.g <= 1);
     assert(0 <= color.b && color.b <= 1);
 
-    // Scale scene so it fits entirely in the window,
-    // with the center of the scene at the center of the window
-    int *width = malloc(sizeof(*width)),
-        *height = malloc(sizeof(*height));
-    assert(width);
-    assert(height);
-    SDL_GetWindowSize(window, width, height);
-    double center_x = *width / 2.0,
-           center_y = *height / 2.0;
-    free(width);
-    free(height);
-    double x_scale = center_x / max_diff.x,
-           y_scale = center_y / max_diff.y;
-    double scale = x_scale < y_scale ? x_scale : y_scale;
+    // The center of the scene is at the center of the window
+    double center_x = width / 2.0,
+           center_y = height / 2.0;
 
     // Convert each vertex to a point on screen
-    short *x_points = malloc(sizeof(*x_points) * n),
-          *y_points = malloc(sizeof(*y_points) * n);
-    assert(x_points);
-    assert(y_points);
+    ArenaMark mark = arena_mark(frame_arena());
+    short *x_points = frame_alloc(sizeof(*x_points) * n),
+          *y_points = frame_alloc(sizeof(*y_points) * n);
+    Vector *vertices = polygon_vertices(points);
     for (size_t i = 0; i < n; i++) {
-        Vector *vertex = list_get(points, i);
-        Vector pos_from_center =
-            vec_multiply(scale, vec_subtract(*vertex, center));
+        Vector pos_from_center = vec_multiply(scale,
+            vec_subtract(transform_apply(transform, vertices[i]), center));
         // Flip y axis since positive y is down on the screen
         x_points[i] = round(center_x + pos_from_center.x);
         y_points[i] = round(center_y - pos_from_center.y);
@@ -163,22 +169,41 @@ void sdl_draw_polygon(List *points, RGBColor color) {
         x_points, y_points, n,
         color.r * 255, color.g * 255, color.b * 255, 255
     );
-    free(x_points);
-    free(y_points);
+    arena_rewind(frame_arena(), mark);
+}
+
+void sdl_draw_polygon_transformed(Polygon *points, Transform2D transform, RGBColor color) {
+    // Scale scene so it fits entirely in the window
+    int width, height;
+    double scale = sdl_window_scale(&width, &height);
+    sdl_draw_polygon_scaled(points, transform, color, width, height, scale);
+}
+
+void sdl_draw_polygon(Polygon *points, RGBColor color) {
+    sdl_draw_polygon_transformed(points, TRANSFORM_IDENTITY, color);
+}
+
+void sdl_draw_body(Body *body) {
+    // Small bodies are drawn from a simplified shape, placed by the body's
+    // transform instead of building its world-space vertices
+    int width, height;
+    double scale = sdl_window_scale(&width, &height);
+    Polygon *shape = shape_prototype_get_render_lod(body_get_prototype(body), scale);
+    sdl_draw_polygon_scaled(shape, body_get_transform(body), body_get_color(body),
+        width, height, scale);
 }
 
 void sdl_show(void) {
     SDL_RenderPresent(renderer);
+    // The frame is over, so none of its temporaries are needed anymore
+    frame_reset();
 }
 
 void sdl_render_scene(Scene *scene) {
     sdl_clear();
     size_t body_count = scene_bodies(scene);
     for (size_t i = 0; i < body_count; i++) {
-        Body *body = scene_get_body(scene, i);
-        List *shape = body_get_shape(body);
-        sdl_draw_polygon(shape, body_get_color(body));
-        //list_free(shape);
+        sdl_draw_body(scene_get_body(scene, i));
     }
     sdl_show();
 }
@@ -3,42 +3,52 @@
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/pool.h"
+
+// Angle between consecutive vertices of a ball, and the number of vertices
+// that step produces over a full turn
+#define BALL_ANGLE_STEP 0.05
+#define BALL_VERTICES ((size_t) ceil(2 * M_PI / BALL_ANGLE_STEP))
 
 struct body_info{
-  BodyType* type;
+  BodyType type;
   size_t life;
-  bool isColliding;
   bool life_lock;
 };
 
-BodyInfo* body_info_init(BodyType* type, size_t life){
-  BodyInfo* info = malloc(sizeof(BodyInfo));
-  assert(info != NULL);
+/**
+ * The pool every BodyInfo is allocated from, created on first use.
+ */
+Pool *body_info_pool = NULL;
+// The number of BodyInfos the pool allocates space for at a time
+const size_t BODY_INFO_POOL_BLOCK = 64;
+
+BodyInfo* body_info_init(BodyType type, size_t life){
+  if(body_info_pool == NULL){
+    body_info_pool = pool_init("BodyInfo", sizeof(BodyInfo), BODY_INFO_POOL_BLOCK);
+  }
+  BodyInfo* info = pool_alloc(body_info_pool);
   info->type = type;
   info->life = life;
-  info->isColliding = false;
   info->life_lock = false;
   return info;
 }
 
 
 void body_info_free(BodyInfo* info){
-  free(info->type);
-  free(info);
+  pool_release(body_info_pool, info);
 }
 
 BodyType body_info_get_type(BodyInfo* info){
-  return *(info->type);
+  return info->type;
 }
 
 size_t body_info_get_life(BodyInfo* info){
   return info->life;
 }
 
-bool body_info_get_collision(BodyInfo* info){
-  return info->isColliding;
-}
-
 bool body_info_get_life_lock(BodyInfo* info){
   return info->life_lock;
 }
@@ -47,42 +57,41 @@ void body_info_set_life(BodyInfo* info, size_t new_life){
   info->life = new_life;
 }
 
-void body_info_set_collision(BodyInfo* info, bool colliding){
-  info->isColliding = colliding;
-}
-
 void body_info_set_life_lock(BodyInfo* info, bool lock){
   info->life_lock = lock;
 }
 
-List *rotate_points(int sides, Vector point){
-  double angle = 2 * M_PI / sides;
-  List *rotated = list_init(sides, free);
+Polygon *rotate_points(size_t sides, Vector point){
+  // Each point is the previous one rotated by one step,
+  // so the trig functions are only evaluated once
+  Transform2D step = transform_rotation(2 * M_PI / sides, VEC_ZERO);
+  Polygon *rotated = polygon_init(sides);
   for(size_t i = 0; i < sides; i++) {
-    list_add(rotated, vec_init(vec_rotate(point, angle * i)));
+    polygon_add(rotated, point);
+    point = transform_apply(step, point);
   }
   return rotated;
 }
 
 // Create a star shape that acts as the visual in counterclockwise
-List *create_star(int sides, Vector position, double radius){
-    double big_r = radius;
-    double small_r = big_r / 2;
+Polygon *create_star(int sides, Vector position, Scalar radius){
+    Scalar big_r = radius;
+    Scalar small_r = big_r / 2;
     Vector outer_point = vec_add(VEC_ZERO, (Vector){0, big_r});
     Vector inner_point = vec_add(VEC_ZERO, (Vector){small_r * cos(M_PI/2 + M_PI/sides), small_r * sin(M_PI/2 + M_PI/sides)});
 
-    List *outer = rotate_points(sides, outer_point);
-    List *inner = rotate_points(sides, inner_point);
-    List *star = list_init(2 * sides, free);
+    Polygon *outer = rotate_points(sides, outer_point);
+    Polygon *inner = rotate_points(sides, inner_point);
+    Polygon *star = polygon_init(2 * sides);
 
     // Combines the list of outer and inner points in counterclockwise direction
-    for(size_t i = 0; i < sides; i++){
-      list_add(star, vec_init(*(Vector*)list_get(outer, i)));
-      list_add(star, vec_init(*(Vector*)list_get(inner, (i % sides))));
+    for(size_t i = 0; i < (size_t) sides; i++){
+      polygon_add(star, polygon_get(outer, i));
+      polygon_add(star, polygon_get(inner, (i % sides)));
     }
 
-    list_free(outer);
-    list_free(inner);
+    polygon_free(outer);
+    polygon_free(inner);
 
     polygon_translate(star, position);
     return star;
@@ -90,100 +99,540 @@ List *create_star(int sides, Vector position, double radius){
 
 // Creates a rectangular shaped block that acts as the visual in counterclockwise
 // order
-List *create_block(Vector position, Vector dimension){
-  List *block = list_init(4, free);
-  list_add(block, vec_init((Vector){dimension.x / 2.0, dimension.y / 2.0}));
-  list_add(block, vec_init((Vector){dimension.x / 2.0, -dimension.y / 2.0}));
-  list_add(block, vec_init((Vector){-dimension.x / 2.0, -dimension.y / 2.0}));
-  list_add(block, vec_init((Vector){-dimension.x / 2.0, dimension.y / 2.0}));
+Polygon *create_block(Vector position, Vector dimension){
+  Polygon *block = polygon_init(4);
+  polygon_add(block, (Vector){dimension.x / 2.0, dimension.y / 2.0});
+  polygon_add(block, (Vector){dimension.x / 2.0, -dimension.y / 2.0});
+  polygon_add(block, (Vector){-dimension.x / 2.0, -dimension.y / 2.0});
+  polygon_add(block, (Vector){-dimension.x / 2.0, dimension.y / 2.0});
   polygon_translate(block, position);
   return block;
 }
 
 // Creates a circle shape that acts as the visual in counterclockwise
 // order
-List *create_ball(Vector position, double radius){
-  List *ball = list_init(75, free);
-  for(double angle = 0.0; angle < 2 * M_PI; angle += 0.05){
-    list_add(ball, vec_init(vec_multiply(radius, (Vector){cos(angle), sin(angle)})));
+Polygon *create_ball(Vector position, Scalar radius){
+  Polygon *ball = polygon_init(BALL_VERTICES);
+  for(Scalar angle = 0.0; angle < 2 * M_PI; angle += BALL_ANGLE_STEP){
+    polygon_add(ball, vec_multiply(radius, (Vector){cos(angle), sin(angle)}));
   }
   polygon_translate(ball, position);
   return ball;
 }
 
+// The number of render levels of detail, the first being the full shape
+#define SHAPE_RENDER_LODS 4
+
+// How far each render level may stray from the full shape, as a fraction of
+// the shape's size (half the diagonal of its bounds)
+const Scalar SHAPE_RENDER_TOLERANCES[SHAPE_RENDER_LODS] = {0, 0.005, 0.02, 0.08};
+// How far the collision level may stray from the full shape, likewise
+const Scalar SHAPE_COLLISION_TOLERANCE = 0.005;
+// How far a drawn outline may stray from the full shape, in pixels
+const Scalar SHAPE_LOD_PIXEL_ERROR = 0.5;
+
+struct shape_prototype{
+  Polygon *local;
+  Scalar area;
+  AABB bounds;
+  // Whether the shape is a rectangle whose sides are parallel to the axes,
+  // so it is exactly its bounds until it is rotated
+  bool box;
+  // Simplified copies of local, from local itself to the coarsest, built the
+  // first time any level is asked for. A level that drops no more vertices
+  // than the one before it shares that level's polygon.
+  bool lods_built;
+  Polygon *render_lods[SHAPE_RENDER_LODS];
+  // How far each render level may stray from local, in scene units
+  Scalar render_errors[SHAPE_RENDER_LODS];
+  Polygon *collision_lod;
+  // The distinct unit edge normals of collision_lod, i.e. its separating axes
+  Vector *axes;
+  size_t axis_count;
+  // The convex pieces of collision_lod; a single piece shares its shape and axes
+  ShapePiece *pieces;
+  size_t piece_count;
+  Vector offset;
+  size_t references;
+  // The registry key; size is the dimension of a block and the radius
+  // (in x) of stars and balls
+  ShapeKind kind;
+  int sides;
+  Vector size;
+  // Whether the prototype is in the registry, and the next prototype in its
+  // bucket there
+  bool registered;
+  ShapePrototype *next;
+};
+
+/**
+ * The registry: a hash table of prototypes by key, chained through their
+ * next pointers. It holds no references, so a prototype leaves it when the
+ * last body using it releases it. Created on first use.
+ */
+ShapePrototype **shape_prototype_buckets = NULL;
+// The number of buckets, a power of 2, and of prototypes in them
+size_t shape_prototype_bucket_count = 0;
+size_t shape_prototype_registered = 0;
+// The number of buckets the registry starts with
+const size_t SHAPE_PROTOTYPES_INITIAL = 16;
+
+// Returns whether a polygon is a rectangle with sides parallel to the axes,
+// e.g. one made by create_block()
+bool shape_is_box(Polygon *shape){
+  if(polygon_size(shape) != 4){
+    return false;
+  }
+  // Every side must be horizontal or vertical, and turn a corner at each end
+  Vector *vertices = polygon_vertices(shape);
+  for(size_t i = 0; i < 4; i++){
+    Vector edge = vec_subtract(vertices[(i + 1) % 4], vertices[i]);
+    Vector next = vec_subtract(vertices[(i + 2) % 4], vertices[(i + 1) % 4]);
+    if((edge.x == 0) == (edge.y == 0) || (edge.x == 0) == (next.x == 0)){
+      return false;
+    }
+  }
+  return true;
+}
+
+// Hashes a registry key. Sizes are hashed by their bits, with -0 folded into
+// 0 first since the two compare equal.
+size_t shape_prototype_hash(ShapeKind kind, int sides, Vector size){
+  Scalar parts[2] = {size.x + 0, size.y + 0};
+  uint64_t bits[2] = {0, 0};
+  memcpy(&bits[0], &parts[0], sizeof(Scalar));
+  memcpy(&bits[1], &parts[1], sizeof(Scalar));
+  uint64_t hash = (uint64_t) kind * 0x9E3779B97F4A7C15ULL ^ (uint32_t) sides;
+  hash = (hash ^ bits[0]) * 0xC2B2AE3D27D4EB4FULL;
+  hash = (hash ^ (hash >> 29) ^ bits[1]) * 0x165667B19E3779F9ULL;
+  return (size_t) (hash ^ (hash >> 32));
+}
+
+// Gets the bucket of the registry a prototype with the given key belongs in
+ShapePrototype **shape_prototype_bucket(ShapeKind kind, int sides, Vector size){
+  size_t mask = shape_prototype_bucket_count - 1;
+  return &shape_prototype_buckets[shape_prototype_hash(kind, sides, size) & mask];
+}
+
+// Removes a prototype from the bucket it is chained in
+void shape_prototype_unregister(ShapePrototype *prototype){
+  ShapePrototype **link = shape_prototype_bucket(prototype->kind, prototype->sides, prototype->size);
+  while(*link != prototype){
+    link = &(*link)->next;
+  }
+  *link = prototype->next;
+  prototype->next = NULL;
+  prototype->registered = false;
+  shape_prototype_registered--;
+}
+
+ShapePrototype *shape_prototype_init(Polygon *local){
+  ShapePrototype *prototype = malloc(sizeof(ShapePrototype));
+  assert(prototype != NULL);
+  prototype->local = local;
+  prototype->area = polygon_area(local);
+  prototype->bounds = polygon_bounds(local);
+  prototype->box = shape_is_box(local);
+  prototype->lods_built = false;
+  prototype->offset = VEC_ZERO;
+  prototype->references = 1;
+  prototype->kind = SHAPE_CUSTOM;
+  prototype->sides = 0;
+  prototype->size = VEC_ZERO;
+  prototype->registered = false;
+  prototype->next = NULL;
+  return prototype;
+}
+
+ShapePrototype *shape_prototype_retain(ShapePrototype *prototype){
+  prototype->references++;
+  return prototype;
+}
+
+void shape_prototype_release(ShapePrototype *prototype){
+  assert(prototype->references > 0);
+  prototype->references--;
+  if(prototype->references == 0){
+    if(prototype->registered){
+      shape_prototype_unregister(prototype);
+    }
+    if(prototype->lods_built){
+      for(size_t i = 1; i < SHAPE_RENDER_LODS; i++){
+        if(prototype->render_lods[i] != prototype->render_lods[i - 1]){
+          polygon_free(prototype->render_lods[i]);
+        }
+      }
+      if(prototype->collision_lod != prototype->local){
+        polygon_free(prototype->collision_lod);
+      }
+      if(prototype->pieces[0].shape != prototype->collision_lod){
+        for(size_t i = 0; i < prototype->piece_count; i++){
+          polygon_free(prototype->pieces[i].shape);
+          free(prototype->pieces[i].axes);
+        }
+      }
+      free(prototype->pieces);
+      free(prototype->axes);
+    }
+    polygon_free(prototype->local);
+    free(prototype);
+  }
+}
+
+Polygon *shape_prototype_get_polygon(ShapePrototype *prototype){
+  return prototype->local;
+}
+
+Scalar shape_prototype_get_area(ShapePrototype *prototype){
+  return prototype->area;
+}
+
+AABB shape_prototype_get_bounds(ShapePrototype *prototype){
+  return prototype->bounds;
+}
+
+Vector shape_prototype_get_offset(ShapePrototype *prototype){
+  return prototype->offset;
+}
+
+ShapeKind shape_prototype_get_kind(ShapePrototype *prototype){
+  return prototype->kind;
+}
+
+bool shape_prototype_is_box(ShapePrototype *prototype){
+  return prototype->box;
+}
+
+// Simplifies a prototype's shape to the given tolerance, reusing coarser
+// (the previous level) if that drops no more vertices
+Polygon *shape_prototype_simplify(ShapePrototype *prototype, Polygon *coarser, Scalar tolerance){
+  Polygon *simplified = polygon_simplify(prototype->local, 3, tolerance);
+  if(polygon_size(simplified) == polygon_size(coarser)){
+    polygon_free(simplified);
+    return coarser;
+  }
+  return simplified;
+}
+
+// Sets a piece's bounding circle to the smallest around its bounds' center
+void shape_piece_bound(ShapePiece *piece){
+  AABB bounds = polygon_bounds(piece->shape);
+  piece->center = vec_multiply(0.5, vec_add(bounds.min, bounds.max));
+  piece->radius = 0;
+  Vector *vertices = polygon_vertices(piece->shape);
+  for(size_t i = 0; i < polygon_size(piece->shape); i++){
+    Scalar distance = vec_magnitude(vec_subtract(vertices[i], piece->center));
+    if(distance > piece->radius){
+      piece->radius = distance;
+    }
+  }
+}
+
+// Adds a piece to a prototype, taking ownership of its convex outline
+void shape_prototype_add_piece(ShapePrototype *prototype, Polygon *shape){
+  ShapePiece *piece = &prototype->pieces[prototype->piece_count];
+  piece->shape = shape;
+  piece->axes = malloc(polygon_size(shape) * sizeof(Vector));
+  assert(piece->axes != NULL);
+  piece->axis_count = polygon_edge_normals(shape, piece->axes);
+  shape_piece_bound(piece);
+  prototype->piece_count++;
+}
+
+// Adds the piece made of the centroid and the collision shape's vertices from
+// first to last (wrapping around), or a fan of triangles if that is not convex
+void shape_prototype_add_fan(ShapePrototype *prototype, size_t first, size_t last){
+  Polygon *shape = prototype->collision_lod;
+  size_t size = polygon_size(shape);
+  Vector *vertices = polygon_vertices(shape);
+  Polygon *piece = polygon_init((last + size - first) % size + 2);
+  polygon_add(piece, VEC_ZERO);
+  for(size_t i = first; i != last; i = (i + 1) % size){
+    polygon_add(piece, vertices[i]);
+  }
+  polygon_add(piece, vertices[last]);
+  if(polygon_is_convex(piece)){
+    shape_prototype_add_piece(prototype, piece);
+    return;
+  }
+  polygon_free(piece);
+  for(size_t i = first; i != last; i = (i + 1) % size){
+    Polygon *triangle = polygon_init(3);
+    polygon_add(triangle, VEC_ZERO);
+    polygon_add(triangle, vertices[i]);
+    polygon_add(triangle, vertices[(i + 1) % size]);
+    shape_prototype_add_piece(prototype, triangle);
+  }
+}
+
+// Returns how the collision shape turns at a vertex, relative to its winding:
+// positive outwards, negative at an inward corner
+Scalar shape_prototype_corner_turn(ShapePrototype *prototype, size_t index){
+  Polygon *shape = prototype->collision_lod;
+  size_t size = polygon_size(shape);
+  Vector *vertices = polygon_vertices(shape);
+  Vector edge = vec_subtract(vertices[index], vertices[(index + size - 1) % size]);
+  Vector next = vec_subtract(vertices[(index + 1) % size], vertices[index]);
+  return vec_cross(edge, next) * prototype->area;
+}
+
+// Splits the collision shape into convex pieces. A concave shape whose every
+// edge faces away from the centroid (the origin) is cut along the lines from
+// the centroid to its inward corners, so a star becomes one kite per point.
+void shape_prototype_build_pieces(ShapePrototype *prototype){
+  Polygon *shape = prototype->collision_lod;
+  size_t size = polygon_size(shape);
+  Vector *vertices = polygon_vertices(shape);
+  prototype->pieces = malloc(size * sizeof(ShapePiece));
+  assert(prototype->pieces != NULL);
+  prototype->piece_count = 0;
+
+  bool star_shaped = true;
+  for(size_t i = 0; i < size && star_shaped; i++){
+    star_shaped = vec_cross(vertices[i], vertices[(i + 1) % size]) * prototype->area > 0;
+  }
+  if(polygon_is_convex(shape) || !star_shaped){
+    prototype->pieces[0] = (ShapePiece){shape, prototype->axes, prototype->axis_count, VEC_ZERO, 0};
+    shape_piece_bound(&prototype->pieces[0]);
+    prototype->piece_count = 1;
+    return;
+  }
+
+  size_t first = 0;
+  while(shape_prototype_corner_turn(prototype, first) >= 0){
+    first++;
+  }
+  size_t start = first;
+  for(size_t k = 1; k <= size; k++){
+    size_t i = (first + k) % size;
+    if(k == size || shape_prototype_corner_turn(prototype, i) < 0){
+      shape_prototype_add_fan(prototype, start, i);
+      start = i;
+    }
+  }
+}
+
+// Builds every level of detail, scaling the tolerances to the shape's size
+void shape_prototype_build_lods(ShapePrototype *prototype){
+  Vector diagonal = vec_subtract(prototype->bounds.max, prototype->bounds.min);
+  Scalar size = sqrt(vec_dot(diagonal, diagonal)) / 2;
+  prototype->render_lods[0] = prototype->local;
+  prototype->render_errors[0] = 0;
+  for(size_t i = 1; i < SHAPE_RENDER_LODS; i++){
+    prototype->render_errors[i] = SHAPE_RENDER_TOLERANCES[i] * size;
+    prototype->render_lods[i] = shape_prototype_simplify(prototype,
+      prototype->render_lods[i - 1], prototype->render_errors[i]);
+  }
+  prototype->collision_lod = shape_prototype_simplify(prototype, prototype->local,
+    SHAPE_COLLISION_TOLERANCE * size);
+  prototype->axes = malloc(polygon_size(prototype->collision_lod) * sizeof(Vector));
+  assert(prototype->axes != NULL);
+  prototype->axis_count = polygon_edge_normals(prototype->collision_lod, prototype->axes);
+  shape_prototype_build_pieces(prototype);
+  prototype->lods_built = true;
+}
+
+Polygon *shape_prototype_get_collision_lod(ShapePrototype *prototype){
+  if(!prototype->lods_built){
+    shape_prototype_build_lods(prototype);
+  }
+  return prototype->collision_lod;
+}
+
+Vector *shape_prototype_get_axes(ShapePrototype *prototype, size_t *count){
+  if(!prototype->lods_built){
+    shape_prototype_build_lods(prototype);
+  }
+  *count = prototype->axis_count;
+  return prototype->axes;
+}
+
+ShapePiece *shape_prototype_get_pieces(ShapePrototype *prototype, size_t *count){
+  if(!prototype->lods_built){
+    shape_prototype_build_lods(prototype);
+  }
+  *count = prototype->piece_count;
+  return prototype->pieces;
+}
+
+Polygon *shape_prototype_get_render_lod(ShapePrototype *prototype, Scalar pixels_per_unit){
+  if(!prototype->lods_built){
+    shape_prototype_build_lods(prototype);
+  }
+  // Picks the coarsest level whose error is still too small to see
+  size_t level = 0;
+  while(level + 1 < SHAPE_RENDER_LODS &&
+    prototype->render_errors[level + 1] * pixels_per_unit <= SHAPE_LOD_PIXEL_ERROR){
+    level++;
+  }
+  return prototype->render_lods[level];
+}
+
+// Finds the registered prototype with the given key, or returns NULL
+ShapePrototype *shape_prototype_find(ShapeKind kind, int sides, Vector size){
+  if(shape_prototype_buckets == NULL){
+    return NULL;
+  }
+  for(ShapePrototype *prototype = *shape_prototype_bucket(kind, sides, size);
+    prototype != NULL; prototype = prototype->next){
+    if(prototype->kind == kind && prototype->sides == sides &&
+      prototype->size.x == size.x && prototype->size.y == size.y){
+      return prototype;
+    }
+  }
+  return NULL;
+}
+
+// Doubles the number of buckets in the registry, or creates it, and
+// rechains every prototype
+void shape_prototype_grow(void){
+  ShapePrototype **old = shape_prototype_buckets;
+  size_t old_count = shape_prototype_bucket_count;
+  shape_prototype_bucket_count = old_count == 0 ? SHAPE_PROTOTYPES_INITIAL : old_count * 2;
+  shape_prototype_buckets = calloc(shape_prototype_bucket_count, sizeof(ShapePrototype *));
+  assert(shape_prototype_buckets != NULL);
+  for(size_t i = 0; i < old_count; i++){
+    ShapePrototype *prototype = old[i];
+    while(prototype != NULL){
+      ShapePrototype *next = prototype->next;
+      ShapePrototype **bucket = shape_prototype_bucket(prototype->kind, prototype->sides, prototype->size);
+      prototype->next = *bucket;
+      *bucket = prototype;
+      prototype = next;
+    }
+  }
+  free(old);
+}
+
+// Registers a shape built around the origin under the given key, moving it
+// to be relative to its centroid
+ShapePrototype *shape_prototype_register(Polygon *shape, ShapeKind kind, int sides, Vector size){
+  Vector offset = polygon_centroid(shape);
+  polygon_translate(shape, vec_negate(offset));
+  ShapePrototype *prototype = shape_prototype_init(shape);
+  prototype->offset = offset;
+  prototype->kind = kind;
+  prototype->sides = sides;
+  prototype->size = size;
+  // Keeps at most one prototype per bucket on average
+  if(shape_prototype_registered >= shape_prototype_bucket_count){
+    shape_prototype_grow();
+  }
+  ShapePrototype **bucket = shape_prototype_bucket(kind, sides, size);
+  prototype->next = *bucket;
+  *bucket = prototype;
+  prototype->registered = true;
+  shape_prototype_registered++;
+  return prototype;
+}
+
+// Takes a new reference to the registered prototype with the given key, or
+// returns NULL if there is none
+ShapePrototype *shape_prototype_lookup(ShapeKind kind, int sides, Vector size){
+  ShapePrototype *prototype = shape_prototype_find(kind, sides, size);
+  return prototype == NULL ? NULL : shape_prototype_retain(prototype);
+}
+
+ShapePrototype *shape_prototype_star(int sides, Scalar radius){
+  Vector size = {radius, 0};
+  ShapePrototype *prototype = shape_prototype_lookup(SHAPE_STAR, sides, size);
+  if(prototype == NULL){
+    prototype = shape_prototype_register(create_star(sides, VEC_ZERO, radius), SHAPE_STAR, sides, size);
+  }
+  return prototype;
+}
+
+ShapePrototype *shape_prototype_block(Vector dimension){
+  ShapePrototype *prototype = shape_prototype_lookup(SHAPE_BLOCK, 4, dimension);
+  if(prototype == NULL){
+    prototype = shape_prototype_register(create_block(VEC_ZERO, dimension), SHAPE_BLOCK, 4, dimension);
+  }
+  return prototype;
+}
+
+ShapePrototype *shape_prototype_ball(Scalar radius){
+  Vector size = {radius, 0};
+  ShapePrototype *prototype = shape_prototype_lookup(SHAPE_BALL, 0, size);
+  if(prototype == NULL){
+    prototype = shape_prototype_register(create_ball(VEC_ZERO, radius), SHAPE_BALL, 0, size);
+  }
+  return prototype;
+}
+
+size_t shape_prototype_count(void){
+  return shape_prototype_registered;
+}
+
+void shape_prototype_clear(void){
+  for(size_t i = 0; i < shape_prototype_bucket_count; i++){
+    while(shape_prototype_buckets[i] != NULL){
+      shape_prototype_unregister(shape_prototype_buckets[i]);
+    }
+  }
+  free(shape_prototype_buckets);
+  shape_prototype_buckets = NULL;
+  shape_prototype_bucket_count = 0;
+}
+
 // Initializes a star Body using a position, dimension, mass and color with a specified type
-Body *star_init(int sides, Vector position, double radius, double mass, RGBColor color, size_t life, BodyType* type){
+Body *star_init(int sides, Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life, BodyType type){
   BodyInfo* body_info = body_info_init(type, life);
-  return body_init_with_info(create_star(sides, position, radius), mass, color, (void*) body_info, (FreeFunc) body_info_free, radius);
+  Body *star = body_init_with_prototype(shape_prototype_star(sides, radius), position, mass, color, (void*) body_info, (FreeFunc) body_info_free, radius);
+  body_set_category(star, type);
+  return star;
 }
 
 // Initializes a PLAYER star
-Body *player_init(int sides, Vector position, double radius, double mass, RGBColor color, size_t life){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = PLAYER;
-  return star_init(sides, position, radius, mass, color, life, type);
+Body *player_init(int sides, Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life){
+  return star_init(sides, position, radius, mass, color, life, PLAYER);
 }
 
 // Initializes a SPIKE star
-Body *spike_init(Vector position, double radius, double mass, RGBColor color, size_t life){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = SPIKE;
-  return star_init(3, position, radius, mass, color, life, type);
+Body *spike_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life){
+  return star_init(3, position, radius, mass, color, life, SPIKE);
 }
 
 // Initializes a block Body using a position, dimension and color with a specified
 // info of PLATFORM
 Body *block_init(Vector position, Vector dimension, RGBColor color, size_t life, bool isTrigger){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
   // If isTrigger is true, then set type to PLATFORM_TRIGGER; else, indicate regular
   // PLATFORM
+  BodyType type = PLATFORM;
   if(isTrigger) {
-    *type = PLATFORM_TRIGGER;
-  }
-  else {
-    *type = PLATFORM;
+    type = PLATFORM_TRIGGER;
   }
   BodyInfo* body_info = body_info_init(type, life);
-  return body_init_with_info(create_block(position, dimension), INFINITY, color, (void*) body_info, (FreeFunc) body_info_free, 1.0 / 2.0 * dimension.y);
+  Body *block = body_init_with_prototype(shape_prototype_block(dimension), position, INFINITY, color, (void*) body_info, (FreeFunc) body_info_free, 1.0 / 2.0 * dimension.y);
+  body_set_category(block, type);
+  return block;
 }
 
 Body *boundary_init(Vector position, Vector dimension, RGBColor color, size_t life){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  // If isTrigger is true, then set type to PLATFORM_TRIGGER; else, indicate regular
-  // PLATFORM
-  *type = BOUND;
-  BodyInfo* body_info = body_info_init(type, life);
-  return body_init_with_info(create_block(position, dimension), INFINITY, color, (void*) body_info, (FreeFunc) body_info_free, 1.0 / 2.0 * dimension.y);
+  BodyInfo* body_info = body_info_init(BOUND, life);
+  Body *boundary = body_init_with_prototype(shape_prototype_block(dimension), position, INFINITY, color, (void*) body_info, (FreeFunc) body_info_free, 1.0 / 2.0 * dimension.y);
+  body_set_category(boundary, BOUND);
+  return boundary;
 }
 
-Body *ball_init(Vector position, double radius, double mass, RGBColor color, size_t life, BodyType* type){
+Body *ball_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life, BodyType type){
   BodyInfo* body_info = body_info_init(type, life);
-  return body_init_with_info(create_ball(position, radius), mass, color, (void*) body_info, (FreeFunc) body_info_free, radius);
+  Body *ball = body_init_with_prototype(shape_prototype_ball(radius), position, mass, color, (void*) body_info, (FreeFunc) body_info_free, radius);
+  // Collides as the circle it approximates
+  body_set_circle(ball, true);
+  body_set_category(ball, type);
+  return ball;
 }
 
 // Initializes a block Body using a position, dimension, mass and color with a specified
 // info of POINT
-Body *point_init(Vector position, double radius, double mass, RGBColor color, size_t life){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = POINT;
-  return ball_init(position, radius, mass, color, life, type);
+Body *point_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life){
+  return ball_init(position, radius, mass, color, life, POINT);
 }
 
-Body *gravity_ball_init(Vector position, double radius, double mass, RGBColor color, size_t life){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = GRAVITY_BALL;
-  return ball_init(position, radius, mass, color, life, type);
+Body *gravity_ball_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life){
+  return ball_init(position, radius, mass, color, life, GRAVITY_BALL);
 }
 
-Body *moving_ball_init(Vector position, double radius, double mass, RGBColor color, size_t life){
-  BodyType *type = malloc(sizeof(*type));
-  assert(type != NULL);
-  *type = MOVING_BALL;
-  return ball_init(position, radius, mass, color, life, type);
+Body *moving_ball_init(Vector position, Scalar radius, Scalar mass, RGBColor color, size_t life){
+  return ball_init(position, radius, mass, color, life, MOVING_BALL);
 }
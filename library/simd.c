@@ -0,0 +1,277 @@
+#include "simd.h"
+#include <assert.h>
+
+#if !defined(SIMD_SCALAR) && defined(__AVX2__)
+#define SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#define SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(SIMD_AVX2) || defined(SIMD_SSE2)
+#define SIMD_VECTORIZED
+#endif
+
+// The kernels are written once against the operations below, which map onto
+// the double or float intrinsics depending on the Scalar type.
+// A Vector of doubles fills half of a 128-bit register, so a register holds
+// one vertex (two in 256 bits); a Vector of floats fills a quarter, so it
+// holds two (four in 256 bits).
+// Loads and stores are unaligned since Vector is only aligned to a Scalar.
+#if defined(SIMD_VECTORIZED) && !defined(SCALAR_FLOAT)
+typedef __m128d Wide128;
+#define VERTICES_128 1
+#define load128(p) _mm_loadu_pd(p)
+#define store128(p, v) _mm_storeu_pd(p, v)
+#define add128 _mm_add_pd
+#define mul128 _mm_mul_pd
+#define min128 _mm_min_pd
+#define max128 _mm_max_pd
+#define splat128(s) _mm_set1_pd(s)
+#define pair128(x, y) _mm_setr_pd(x, y)
+// (x, y) -> (y, x) for every vertex
+#define swap128(v) _mm_shuffle_pd(v, v, 0x1)
+// Splits the vertices of a and b into their x and y coordinates, in any order
+#define split128(a, b, xs, ys) \
+  ((xs) = _mm_unpacklo_pd(a, b), (ys) = _mm_unpackhi_pd(a, b))
+// Combines the vertices of a register into the first vertex
+#define fold_vertices128(op, v) (v)
+#define store_vertex128(p, v) _mm_storeu_pd(p, v)
+// Combines every lane of a register into one Scalar
+#define fold_min128(v) _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v)))
+#define fold_max128(v) _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)))
+#elif defined(SIMD_VECTORIZED)
+typedef __m128 Wide128;
+#define VERTICES_128 2
+#define load128(p) _mm_loadu_ps(p)
+#define store128(p, v) _mm_storeu_ps(p, v)
+#define add128 _mm_add_ps
+#define mul128 _mm_mul_ps
+#define min128 _mm_min_ps
+#define max128 _mm_max_ps
+#define splat128(s) _mm_set1_ps(s)
+#define pair128(x, y) _mm_setr_ps(x, y, x, y)
+#define swap128(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))
+#define split128(a, b, xs, ys) \
+  ((xs) = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), \
+   (ys) = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)))
+#define fold_vertices128(op, v) op(v, _mm_movehl_ps(v, v))
+#define store_vertex128(p, v) _mm_storel_pi((__m64 *) (p), v)
+#define fold_min128(v) fold_lanes128(_mm_min_ps, _mm_min_ss, v)
+#define fold_max128(v) fold_lanes128(_mm_max_ps, _mm_max_ss, v)
+#define fold_lanes128(op, op_ss, v) \
+  _mm_cvtss_f32(op_ss(op(v, _mm_movehl_ps(v, v)), \
+    _mm_shuffle_ps(op(v, _mm_movehl_ps(v, v)), v, _MM_SHUFFLE(1, 1, 1, 1))))
+#endif
+
+#if defined(SIMD_AVX2) && !defined(SCALAR_FLOAT)
+typedef __m256d Wide256;
+#define VERTICES_256 2
+#define load256(p) _mm256_loadu_pd(p)
+#define store256(p, v) _mm256_storeu_pd(p, v)
+#define add256 _mm256_add_pd
+#define mul256 _mm256_mul_pd
+#define min256 _mm256_min_pd
+#define max256 _mm256_max_pd
+#define splat256(s) _mm256_set1_pd(s)
+#define pair256(x, y) _mm256_setr_pd(x, y, x, y)
+#define swap256(v) _mm256_permute_pd(v, 0x5)
+#define split256(a, b, xs, ys) \
+  ((xs) = _mm256_unpacklo_pd(a, b), (ys) = _mm256_unpackhi_pd(a, b))
+#define low128(v) _mm256_castpd256_pd128(v)
+#define high128(v) _mm256_extractf128_pd(v, 1)
+#elif defined(SIMD_AVX2)
+typedef __m256 Wide256;
+#define VERTICES_256 4
+#define load256(p) _mm256_loadu_ps(p)
+#define store256(p, v) _mm256_storeu_ps(p, v)
+#define add256 _mm256_add_ps
+#define mul256 _mm256_mul_ps
+#define min256 _mm256_min_ps
+#define max256 _mm256_max_ps
+#define splat256(s) _mm256_set1_ps(s)
+#define pair256(x, y) _mm256_setr_ps(x, y, x, y, x, y, x, y)
+#define swap256(v) _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1))
+#define split256(a, b, xs, ys) \
+  ((xs) = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), \
+   (ys) = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)))
+#define low128(v) _mm256_castps256_ps128(v)
+#define high128(v) _mm256_extractf128_ps(v, 1)
+#endif
+
+const char *simd_implementation(void) {
+#if defined(SIMD_AVX2)
+  return "avx2";
+#elif defined(SIMD_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+void simd_translate(Vector *vertices, size_t size, Vector translation) {
+  size_t i = 0;
+#ifdef SIMD_VECTORIZED
+  Scalar *data = (Scalar *) vertices;
+#endif
+#if defined(SIMD_AVX2)
+  Wide256 t4 = pair256(translation.x, translation.y);
+  for(; i + VERTICES_256 <= size; i += VERTICES_256) {
+    store256(data + 2 * i, add256(load256(data + 2 * i), t4));
+  }
+#endif
+#ifdef SIMD_VECTORIZED
+  Wide128 t2 = pair128(translation.x, translation.y);
+  for(; i + VERTICES_128 <= size; i += VERTICES_128) {
+    store128(data + 2 * i, add128(load128(data + 2 * i), t2));
+  }
+#endif
+  for(; i < size; i++) {
+    vertices[i].x += translation.x;
+    vertices[i].y += translation.y;
+  }
+}
+
+void simd_transform(const Vector *source, Vector *destination, size_t size,
+    Scalar cos_angle, Scalar sin_angle, Vector translation) {
+  size_t i = 0;
+#ifdef SIMD_VECTORIZED
+  const Scalar *data = (const Scalar *) source;
+  Scalar *out = (Scalar *) destination;
+#endif
+  // (x, y) becomes (x * cos - y * sin, y * cos + x * sin) + translation,
+  // which is (x, y) * cos + (y, x) * (-sin, sin) + translation
+#if defined(SIMD_AVX2)
+  Wide256 t4 = pair256(translation.x, translation.y);
+  Wide256 c4 = splat256(cos_angle);
+  Wide256 s4 = pair256(-sin_angle, sin_angle);
+  for(; i + VERTICES_256 <= size; i += VERTICES_256) {
+    Wide256 v = load256(data + 2 * i);
+    Wide256 rotated = add256(mul256(v, c4), mul256(swap256(v), s4));
+    store256(out + 2 * i, add256(rotated, t4));
+  }
+#endif
+#ifdef SIMD_VECTORIZED
+  Wide128 t2 = pair128(translation.x, translation.y);
+  Wide128 c2 = splat128(cos_angle);
+  Wide128 s2 = pair128(-sin_angle, sin_angle);
+  for(; i + VERTICES_128 <= size; i += VERTICES_128) {
+    Wide128 v = load128(data + 2 * i);
+    Wide128 rotated = add128(mul128(v, c2), mul128(swap128(v), s2));
+    store128(out + 2 * i, add128(rotated, t2));
+  }
+#endif
+  for(; i < size; i++) {
+    Scalar x = source[i].x;
+    Scalar y = source[i].y;
+    destination[i].x = x * cos_angle + y * -sin_angle + translation.x;
+    destination[i].y = y * cos_angle + x * sin_angle + translation.y;
+  }
+}
+
+void simd_project(const Vector *vertices, size_t size, Vector axis, Scalar *min, Scalar *max) {
+  assert(size > 0);
+  size_t i = 0;
+  Scalar lo = vertices[0].x * axis.x + vertices[0].y * axis.y;
+  Scalar hi = lo;
+#ifdef SIMD_VECTORIZED
+  const Scalar *data = (const Scalar *) vertices;
+  // Two registers of vertices are split into one of x and one of y coordinates,
+  // whose lanes then hold the projections of all of those vertices.
+  // The order of the vertices does not matter for the minimum and maximum.
+  if(size >= 2 * VERTICES_128) {
+    Wide128 ax2 = splat128(axis.x);
+    Wide128 ay2 = splat128(axis.y);
+    Wide128 lo2 = splat128(lo);
+    Wide128 hi2 = lo2;
+#if defined(SIMD_AVX2)
+    if(size >= 2 * VERTICES_256) {
+      Wide256 ax4 = splat256(axis.x);
+      Wide256 ay4 = splat256(axis.y);
+      Wide256 lo4 = splat256(lo);
+      Wide256 hi4 = lo4;
+      for(; i + 2 * VERTICES_256 <= size; i += 2 * VERTICES_256) {
+        Wide256 xs, ys;
+        split256(load256(data + 2 * i), load256(data + 2 * i + 2 * VERTICES_256), xs, ys);
+        Wide256 p = add256(mul256(xs, ax4), mul256(ys, ay4));
+        lo4 = min256(lo4, p);
+        hi4 = max256(hi4, p);
+      }
+      lo2 = min128(low128(lo4), high128(lo4));
+      hi2 = max128(low128(hi4), high128(hi4));
+    }
+#endif
+    for(; i + 2 * VERTICES_128 <= size; i += 2 * VERTICES_128) {
+      Wide128 xs, ys;
+      split128(load128(data + 2 * i), load128(data + 2 * i + 2 * VERTICES_128), xs, ys);
+      Wide128 p = add128(mul128(xs, ax2), mul128(ys, ay2));
+      lo2 = min128(lo2, p);
+      hi2 = max128(hi2, p);
+    }
+    lo = fold_min128(lo2);
+    hi = fold_max128(hi2);
+  }
+#endif
+  for(; i < size; i++) {
+    Scalar p = vertices[i].x * axis.x + vertices[i].y * axis.y;
+    if(p < lo) {
+      lo = p;
+    }
+    if(p > hi) {
+      hi = p;
+    }
+  }
+  *min = lo;
+  *max = hi;
+}
+
+void simd_bounds(const Vector *vertices, size_t size, Vector *min, Vector *max) {
+  assert(size > 0);
+  size_t i = 0;
+  Vector lo = vertices[0];
+  Vector hi = vertices[0];
+#ifdef SIMD_VECTORIZED
+  const Scalar *data = (const Scalar *) vertices;
+  // Each lane holds the x or y coordinate of a running bound
+  if(size >= VERTICES_128) {
+    Wide128 lo2 = pair128(lo.x, lo.y);
+    Wide128 hi2 = lo2;
+#if defined(SIMD_AVX2)
+    if(size >= VERTICES_256) {
+      Wide256 lo4 = pair256(lo.x, lo.y);
+      Wide256 hi4 = lo4;
+      for(; i + VERTICES_256 <= size; i += VERTICES_256) {
+        Wide256 v = load256(data + 2 * i);
+        lo4 = min256(lo4, v);
+        hi4 = max256(hi4, v);
+      }
+      lo2 = min128(low128(lo4), high128(lo4));
+      hi2 = max128(low128(hi4), high128(hi4));
+    }
+#endif
+    for(; i + VERTICES_128 <= size; i += VERTICES_128) {
+      Wide128 v = load128(data + 2 * i);
+      lo2 = min128(lo2, v);
+      hi2 = max128(hi2, v);
+    }
+    store_vertex128((Scalar *) &lo, fold_vertices128(min128, lo2));
+    store_vertex128((Scalar *) &hi, fold_vertices128(max128, hi2));
+  }
+#endif
+  for(; i < size; i++) {
+    if(vertices[i].x < lo.x) {
+      lo.x = vertices[i].x;
+    }
+    if(vertices[i].x > hi.x) {
+      hi.x = vertices[i].x;
+    }
+    if(vertices[i].y < lo.y) {
+      lo.y = vertices[i].y;
+    }
+    if(vertices[i].y > hi.y) {
+      hi.y = vertices[i].y;
+    }
+  }
+  *min = lo;
+  *max = hi;
+}
@@ -7,7 +7,7 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
-#define DEFAULT_EPSILON 1e-7
+#define DEFAULT_EPSILON SCALAR_EPSILON
 
 bool isclose(double d1, double d2) {
     return within(DEFAULT_EPSILON, d1, d2);
@@ -22,6 +22,10 @@ bool vec_isclose(Vector v1, Vector v2) {
 }
 
 bool within(double epsilon, double d1, double d2) {
+#ifdef SCALAR_FLOAT
+    // Single-precision error grows with the magnitude of the values compared
+    epsilon *= fmax(1, fmax(fabs(d1), fabs(d2)));
+#endif
     return fabs(d1 - d2) < epsilon;
 }
 
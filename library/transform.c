@@ -0,0 +1,52 @@
+#include "transform.h"
+#include "simd.h"
+#include <math.h>
+
+const Transform2D TRANSFORM_IDENTITY = {
+  .cos_angle = 1,
+  .sin_angle = 0,
+  .translation = {0, 0}
+};
+
+// Rotates v by the rotation of a transform, without translating it
+Vector transform_rotate(Transform2D transform, Vector v){
+  return (Vector){
+    .x = v.x * transform.cos_angle - v.y * transform.sin_angle,
+    .y = v.x * transform.sin_angle + v.y * transform.cos_angle
+  };
+}
+
+Transform2D transform_translation(Vector translation){
+  return (Transform2D){1, 0, translation};
+}
+
+Transform2D transform_rotation(Scalar angle, Vector point){
+  Transform2D transform = {cos(angle), sin(angle), VEC_ZERO};
+  // Rotating about point is v -> R(v - point) + point = Rv + (point - R point)
+  transform.translation = vec_subtract(point, transform_rotate(transform, point));
+  return transform;
+}
+
+Transform2D transform_compose(Transform2D outer, Transform2D inner){
+  // R_o(R_i v + t_i) + t_o = (R_o R_i) v + (R_o t_i + t_o)
+  return (Transform2D){
+    .cos_angle = outer.cos_angle * inner.cos_angle - outer.sin_angle * inner.sin_angle,
+    .sin_angle = outer.sin_angle * inner.cos_angle + outer.cos_angle * inner.sin_angle,
+    .translation = vec_add(transform_rotate(outer, inner.translation), outer.translation)
+  };
+}
+
+Transform2D transform_invert(Transform2D transform){
+  // The inverse of a rotation is its transpose, so v = R^T (v' - t)
+  Transform2D inverse = {transform.cos_angle, -transform.sin_angle, VEC_ZERO};
+  inverse.translation = vec_negate(transform_rotate(inverse, transform.translation));
+  return inverse;
+}
+
+Vector transform_apply(Transform2D transform, Vector v){
+  return vec_add(transform_rotate(transform, v), transform.translation);
+}
+
+void transform_apply_array(Transform2D transform, Vector *vertices, size_t size){
+  simd_transform(vertices, vertices, size, transform.cos_angle, transform.sin_angle, transform.translation);
+}
@@ -34,7 +34,7 @@ Vector vec_negate(Vector v) {
   return vec_multiply(-1, v);
 }
 
-Vector vec_multiply(double scalar, Vector v) {
+Vector vec_multiply(Scalar scalar, Vector v) {
   Vector product = {
     .x = v.x * scalar,
     .y = v.y * scalar
@@ -42,22 +42,22 @@ Vector vec_multiply(double scalar, Vector v) {
   return product;
 }
 
-double vec_dot(Vector v1, Vector v2) {
-  double dot_product = v1.x * v2.x + v1.y * v2.y;
+Scalar vec_dot(Vector v1, Vector v2) {
+  Scalar dot_product = v1.x * v2.x + v1.y * v2.y;
   return dot_product;
 }
 
-double vec_cross(Vector v1, Vector v2) {
-  double cross_product = v1.x * v2.y - v2.x * v1.y;
+Scalar vec_cross(Vector v1, Vector v2) {
+  Scalar cross_product = v1.x * v2.y - v2.x * v1.y;
   return cross_product;
 }
 
-double vec_get_x(Vector v)
+Scalar vec_get_x(Vector v)
 {
   return v.x;
 }
 
-double vec_get_y(Vector v)
+Scalar vec_get_y(Vector v)
 {
   return v.y;
 }
@@ -71,11 +71,11 @@ bool vec_equal(Vector x, Vector y)
   return false;
 }
 
-double vec_magnitude(Vector v){
+Scalar vec_magnitude(Vector v){
   return sqrt(vec_dot(v, v));
 }
 
-Vector vec_rotate(Vector v, double angle) {
+Vector vec_rotate(Vector v, Scalar angle) {
 /** Standard rotation matrix has form (cos(theta), -sin(theta); sin(theta),
  * cos(theta);
  */
@@ -16,20 +16,12 @@
 #include <time.h>
 
 
-List *make_shape() {
-    List *shape = list_init(4, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {-1, -1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, -1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, +1};
-    list_add(shape, v);
+Polygon *make_shape() {
+    Polygon *shape = polygon_init(4);
+    polygon_add(shape, (Vector) {-1, -1});
+    polygon_add(shape, (Vector) {+1, -1});
+    polygon_add(shape, (Vector) {+1, +1});
+    polygon_add(shape, (Vector) {-1, +1});
     return shape;
 }
 
@@ -43,13 +35,13 @@ List *make_shape() {
 / End after 10 full periods
 */
 void test_spring_amp() {
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
     const double K = 10.0;
     const double GAMMA = 0.5;
     Scene *scene = scene_init();
-    Body *invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    Body *visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    Body *invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    Body *visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody, (Vector) {0, 20});
     scene_add_body(scene, invisBody);
     scene_add_body(scene, visBody);
@@ -70,73 +62,73 @@ void test_spring_amp() {
 / does not exceed 1% of starting coordinate (End test after 3 full periods)
 */
 void test_spring_multi() {
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
     double k = 20.0;
     Scene *scene = scene_init();
-    Body *invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    Body *visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    Body *invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    Body *visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody, (Vector) {0, 50});
     scene_add_body(scene, invisBody);
     scene_add_body(scene, visBody);
     create_spring(scene, k, visBody, invisBody);
     for(size_t i = 0; i < STEPS; i++){
         scene_tick(scene, DT);
-        assert(fabs(body_get_centroid(visBody).y) <= 50.1);
+        assert(fabs(body_get_centroid(visBody).y) <= 50.1 + 50 * TEST_DRIFT);
     }
     scene_free(scene);
 
     k = 200.0;
     scene = scene_init();
-    invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody, (Vector) {0, 100});
     scene_add_body(scene, invisBody);
     scene_add_body(scene, visBody);
     create_spring(scene, k, visBody, invisBody);
     for(size_t i = 0; i < STEPS; i++){
         scene_tick(scene, DT);
-        assert(fabs(body_get_centroid(visBody).y) <= 100.1);
+        assert(fabs(body_get_centroid(visBody).y) <= 100.1 + 100 * TEST_DRIFT);
     }
     scene_free(scene);
 
     k = 2000.0;
     scene = scene_init();
-    invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody, (Vector) {0, 150});
     scene_add_body(scene, invisBody);
     scene_add_body(scene, visBody);
     create_spring(scene, k, visBody, invisBody);
     for(size_t i = 0; i < STEPS; i++){
         scene_tick(scene, DT);
-        assert(fabs(body_get_centroid(visBody).y) <= 150.1);
+        assert(fabs(body_get_centroid(visBody).y) <= 150.1 + 150 * TEST_DRIFT);
     }
     scene_free(scene);
 }
 
 // Test amplitude with multiple balls
 void test_spring_multi2() {
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
     double k = 20.0;
     Scene *scene = scene_init();
-    Body *invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    Body *visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    Body *invisBody = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    Body *visBody = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody, (Vector) {0, 50});
     scene_add_body(scene, invisBody);
     scene_add_body(scene, visBody);
     create_spring(scene, k, visBody, invisBody);
 
-    Body *invisBody2 = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    Body *visBody2 = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    Body *invisBody2 = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    Body *visBody2 = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody2, (Vector) {0, 50});
     scene_add_body(scene, invisBody2);
     scene_add_body(scene, visBody2);
     create_spring(scene, k*2, visBody2, invisBody2);
 
-    Body *invisBody3 = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
-    Body *visBody3 = body_init(make_shape(), 2, (RGBColor) {0, 0, 0});
+    Body *invisBody3 = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
+    Body *visBody3 = body_init(make_shape(), 2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(visBody3, (Vector) {0, 50});
     scene_add_body(scene, invisBody3);
     scene_add_body(scene, visBody3);
@@ -144,9 +136,9 @@ void test_spring_multi2() {
 
     for(size_t i = 0; i < STEPS; i++){
         scene_tick(scene, DT);
-        assert(fabs(body_get_centroid(visBody).y) <= 50.1);
-        assert(fabs(body_get_centroid(visBody2).y) <= 50.1);
-        assert(fabs(body_get_centroid(visBody3).y) <= 50.1);
+        assert(fabs(body_get_centroid(visBody).y) <= 50.1 + 50 * TEST_DRIFT);
+        assert(fabs(body_get_centroid(visBody2).y) <= 50.1 + 50 * TEST_DRIFT);
+        assert(fabs(body_get_centroid(visBody3).y) <= 50.1 + 50 * TEST_DRIFT);
     }
     scene_free(scene);
 }
@@ -155,12 +147,12 @@ void test_spring_multi2() {
 void test_extreme_velocity() {
     const double M = 4.0;
     const double G = 1e3;
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
     Scene *scene = scene_init();
-    Body *mass1 = body_init(make_shape(), M, (RGBColor) {0, 0, 0});
-    Body *mass2 = body_init(make_shape(), M, (RGBColor) {0, 0, 0});
-    Body *mass3 = body_init(make_shape(), M, (RGBColor) {0, 0, 0});
+    Body *mass1 = body_init(make_shape(), M, (RGBColor) {0, 0, 0}, 1);
+    Body *mass2 = body_init(make_shape(), M, (RGBColor) {0, 0, 0}, 1);
+    Body *mass3 = body_init(make_shape(), M, (RGBColor) {0, 0, 0}, 1);
     scene_add_body(scene, mass1);
     scene_add_body(scene, mass2);
     scene_add_body(scene, mass3);
@@ -0,0 +1,156 @@
+#include "test_util.h"
+#include "aabb_tree.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BOX_COUNT 300
+
+// Scatters boxes of widely varying sizes
+void make_boxes(AABB *boxes, size_t count) {
+    srand(5);
+    for (size_t i = 0; i < count; i++) {
+        Vector min = {rand() % 400 - 200, rand() % 200 - 100};
+        Vector size = {1 + rand() % 10, 1 + rand() % 10};
+        if (i % 30 == 0) {
+            size = (Vector) {50 + rand() % 300, 5};
+        }
+        boxes[i] = (AABB) {min, vec_add(min, size)};
+    }
+}
+
+void mark_id(size_t id, void *aux) {
+    bool *found = aux;
+    assert(!found[id]);
+    found[id] = true;
+}
+
+typedef struct pair_record {
+    bool found[BOX_COUNT][BOX_COUNT];
+    size_t count;
+} PairRecord;
+
+void mark_pair(size_t id1, size_t id2, void *aux) {
+    PairRecord *record = aux;
+    if (id1 > id2) {
+        size_t swap = id1;
+        id1 = id2;
+        id2 = swap;
+    }
+    assert(!record->found[id1][id2]);
+    record->found[id1][id2] = true;
+    record->count++;
+}
+
+void test_tree_insert_query() {
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    AABBTree *tree = aabb_tree_init(1);
+    size_t proxies[BOX_COUNT];
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        proxies[i] = aabb_tree_insert(tree, boxes[i], i);
+    }
+    assert(aabb_tree_size(tree) == BOX_COUNT);
+    // Balanced, so far shorter than the number of boxes
+    assert(aabb_tree_height(tree) <= 2 * log2(BOX_COUNT) + 2);
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        assert(aabb_tree_get_id(tree, proxies[i]) == i);
+        AABB fat = aabb_tree_get_fat_box(tree, proxies[i]);
+        assert(vec_isclose(fat.min, vec_subtract(boxes[i].min, (Vector) {1, 1})));
+    }
+
+    // A query finds exactly the fattened boxes it overlaps
+    AABB query = {{-20, -20}, {20, 20}};
+    bool found[BOX_COUNT] = {false};
+    aabb_tree_query(tree, query, mark_id, found);
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        assert(found[i] == aabb_overlap(aabb_tree_get_fat_box(tree, proxies[i]), query));
+    }
+    aabb_tree_free(tree);
+}
+
+void test_tree_move_remove() {
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    AABBTree *tree = aabb_tree_init(1);
+    size_t proxies[BOX_COUNT];
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        proxies[i] = aabb_tree_insert(tree, boxes[i], i);
+    }
+    // Moving within the margin changes nothing; further reinserts the box
+    AABB nudged = {vec_add(boxes[0].min, (Vector) {0.5, 0}), vec_add(boxes[0].max, (Vector) {0.5, 0})};
+    assert(!aabb_tree_move(tree, proxies[0], nudged));
+    AABB moved = {{500, 500}, {501, 501}};
+    assert(aabb_tree_move(tree, proxies[0], moved));
+    bool found[BOX_COUNT] = {false};
+    aabb_tree_query(tree, moved, mark_id, found);
+    assert(found[0]);
+
+    // Removing half the boxes keeps the rest findable and the tree balanced
+    for (size_t i = 0; i < BOX_COUNT; i += 2) {
+        aabb_tree_remove(tree, proxies[i]);
+    }
+    assert(aabb_tree_size(tree) == BOX_COUNT / 2);
+    assert(aabb_tree_height(tree) <= 2 * log2(BOX_COUNT / 2) + 2);
+    memset(found, 0, sizeof(found));
+    aabb_tree_query(tree, (AABB) {{-1000, -1000}, {1000, 1000}}, mark_id, found);
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        assert(found[i] == (i % 2 == 1));
+    }
+    // Freed nodes are reused
+    size_t proxy = aabb_tree_insert(tree, boxes[0], 0);
+    assert(proxy < 2 * BOX_COUNT);
+    aabb_tree_free(tree);
+}
+
+void test_tree_pairs() {
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    AABBTree *tree = aabb_tree_init(0.5);
+    AABBTree *other = aabb_tree_init(0.5);
+    size_t proxies[BOX_COUNT];
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        proxies[i] = aabb_tree_insert(i % 2 == 0 ? tree : other, boxes[i], i);
+    }
+    PairRecord *within = calloc(1, sizeof(PairRecord));
+    PairRecord *between = calloc(1, sizeof(PairRecord));
+    aabb_tree_find_pairs(tree, mark_pair, within);
+    aabb_tree_find_pairs_between(tree, other, mark_pair, between);
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        for (size_t j = i + 1; j < BOX_COUNT; j++) {
+            AABB fat1 = aabb_tree_get_fat_box(i % 2 == 0 ? tree : other, proxies[i]);
+            AABB fat2 = aabb_tree_get_fat_box(j % 2 == 0 ? tree : other, proxies[j]);
+            bool overlap = aabb_overlap(fat1, fat2);
+            if (i % 2 == 0 && j % 2 == 0) {
+                assert(within->found[i][j] == overlap);
+            }
+            else if (i % 2 != j % 2) {
+                assert(between->found[i][j] == overlap);
+            }
+        }
+    }
+    assert(within->count > 0 && between->count > 0);
+    free(within);
+    free(between);
+    aabb_tree_free(tree);
+    aabb_tree_free(other);
+}
+
+int main(int argc, char *argv[]) {
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_tree_insert_query)
+    DO_TEST(test_tree_move_remove)
+    DO_TEST(test_tree_pairs)
+
+    puts("aabb_tree_test PASS");
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "test_util.h"
+#include "arena.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+void test_arena_alloc() {
+    Arena *arena = arena_init(64);
+    char *a = arena_alloc(arena, 3);
+    char *b = arena_alloc(arena, 20);
+    assert((uintptr_t) a % 16 == 0);
+    assert((uintptr_t) b % 16 == 0);
+    assert(b >= a + 3);
+    // Larger than the first chunk, so another one is allocated
+    double *c = arena_alloc(arena, sizeof(double) * 100);
+    for (size_t i = 0; i < 100; i++) {
+        c[i] = i;
+    }
+    assert(arena_capacity(arena) >= 64 + sizeof(double) * 100);
+    arena_free(arena);
+}
+
+void test_arena_reset_reuses() {
+    Arena *arena = arena_init(32);
+    void *first = arena_alloc(arena, 16);
+    for (size_t i = 0; i < 100; i++) {
+        arena_alloc(arena, 16);
+    }
+    size_t capacity = arena_capacity(arena);
+    arena_reset(arena);
+    assert(arena_alloc(arena, 16) == first);
+    // The chunks from before the reset are enough, so the arena does not grow
+    for (size_t i = 0; i < 100; i++) {
+        arena_alloc(arena, 16);
+    }
+    assert(arena_capacity(arena) == capacity);
+    arena_free(arena);
+}
+
+void test_arena_rewind() {
+    Arena *arena = arena_init(64);
+    arena_alloc(arena, 16);
+    ArenaMark mark = arena_mark(arena);
+    void *temp = arena_alloc(arena, 16);
+    for (size_t i = 0; i < 20; i++) {
+        arena_alloc(arena, 16);
+    }
+    arena_rewind(arena, mark);
+    assert(arena_alloc(arena, 16) == temp);
+    arena_free(arena);
+}
+
+void test_frame_arena() {
+    void *first = frame_alloc(8);
+    frame_alloc(100);
+    frame_reset();
+    assert(frame_alloc(8) == first);
+    frame_reset();
+}
+
+int main(int argc, char *argv[]) {
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_arena_alloc)
+    DO_TEST(test_arena_reset_reuses)
+    DO_TEST(test_arena_rewind)
+    DO_TEST(test_frame_arena)
+
+    puts("arena_test PASS");
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "body.h"
+#include "shape.h"
 #include "test_util.h"
 #include <assert.h>
 #include <math.h>
@@ -7,20 +8,17 @@
 void test_body_init() {
     Vector v[] = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(0, free);
+    Polygon *shape = polygon_init(0);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
+        polygon_add(shape, v[i]);
     }
     RGBColor color = {0, 0.5, 1};
-    Body *body = body_init(shape, 3, color);
-    List *shape2 = body_get_shape(body);
-    assert(list_size(shape2) == VERTICES);
+    Body *body = body_init(shape, 3, color, 1);
+    Polygon *shape2 = body_get_shape(body);
+    assert(polygon_size(shape2) == VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        assert(vec_isclose(*(Vector *) list_get(shape2, i), v[i]));
+        assert(vec_isclose(polygon_get(shape2, i), v[i]));
     }
-    list_free(shape2);
     assert(vec_isclose(body_get_centroid(body), (Vector) {1.5, 1.5}));
     assert(vec_equal(body_get_velocity(body), VEC_ZERO));
     assert(body_get_color(body).r == color.r);
@@ -31,65 +29,48 @@ void test_body_init() {
 }
 
 void test_body_setters() {
-    List *shape = list_init(3, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {+1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {0, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, 0};
-    list_add(shape, v);
-    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0});
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
+    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
     body_set_velocity(body, (Vector) {+5, -5});
     assert(vec_equal(body_get_velocity(body), (Vector) {+5, -5}));
     assert(vec_isclose(body_get_centroid(body), (Vector) {0, 1.0 / 3.0}));
     body_set_centroid(body, (Vector) {1, 2});
     assert(vec_isclose(body_get_centroid(body), (Vector) {1, 2}));
     shape = body_get_shape(body);
-    assert(list_size(shape) == 3);
-    assert(vec_isclose(*(Vector *) list_get(shape, 0), (Vector) {2, 5.0 / 3.0}));
-    assert(vec_isclose(*(Vector *) list_get(shape, 1), (Vector) {1, 8.0 / 3.0}));
-    assert(vec_isclose(*(Vector *) list_get(shape, 2), (Vector) {0, 5.0 / 3.0}));
-    list_free(shape);
+    assert(polygon_size(shape) == 3);
+    assert(vec_isclose(polygon_get(shape, 0), (Vector) {2, 5.0 / 3.0}));
+    assert(vec_isclose(polygon_get(shape, 1), (Vector) {1, 8.0 / 3.0}));
+    assert(vec_isclose(polygon_get(shape, 2), (Vector) {0, 5.0 / 3.0}));
     body_set_rotation(body, M_PI / 2);
     assert(vec_isclose(body_get_centroid(body), (Vector) {1, 2}));
     shape = body_get_shape(body);
-    assert(list_size(shape) == 3);
-    assert(vec_isclose(*(Vector *) list_get(shape, 0), (Vector) {4.0 / 3.0, 3}));
-    assert(vec_isclose(*(Vector *) list_get(shape, 1), (Vector) {1.0 / 3.0, 2}));
-    assert(vec_isclose(*(Vector *) list_get(shape, 2), (Vector) {4.0 / 3.0, 1}));
-    list_free(shape);
+    assert(polygon_size(shape) == 3);
+    assert(vec_isclose(polygon_get(shape, 0), (Vector) {4.0 / 3.0, 3}));
+    assert(vec_isclose(polygon_get(shape, 1), (Vector) {1.0 / 3.0, 2}));
+    assert(vec_isclose(polygon_get(shape, 2), (Vector) {4.0 / 3.0, 1}));
     body_set_centroid(body, (Vector) {3, 4});
     assert(vec_isclose(body_get_centroid(body), (Vector) {3, 4}));
     shape = body_get_shape(body);
-    assert(list_size(shape) == 3);
-    assert(vec_isclose(*(Vector *) list_get(shape, 0), (Vector) {10.0 / 3.0, 5}));
-    assert(vec_isclose(*(Vector *) list_get(shape, 1), (Vector) {7.0 / 3.0, 4}));
-    assert(vec_isclose(*(Vector *) list_get(shape, 2), (Vector) {10.0 / 3.0, 3}));
-    list_free(shape);
+    assert(polygon_size(shape) == 3);
+    assert(vec_isclose(polygon_get(shape, 0), (Vector) {10.0 / 3.0, 5}));
+    assert(vec_isclose(polygon_get(shape, 1), (Vector) {7.0 / 3.0, 4}));
+    assert(vec_isclose(polygon_get(shape, 2), (Vector) {10.0 / 3.0, 3}));
     body_free(body);
 }
 
 void test_body_tick() {
     const Vector A = {1, 2};
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
-    List *shape = list_init(4, free);
-    Vector *v = malloc(sizeof(*v));
-    v->x = v->y = -1;
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, -1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    v->x = v->y = +1;
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, +1};
-    list_add(shape, v);
-    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0});
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
+    Polygon *shape = polygon_init(4);
+    polygon_add(shape, (Vector) {-1, -1});
+    polygon_add(shape, (Vector) {+1, -1});
+    polygon_add(shape, (Vector) {+1, +1});
+    polygon_add(shape, (Vector) {-1, +1});
+    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
 
     // Apply constant acceleration and ensure position is (a / 2) * t ** 2
     for (int i = 0; i < STEPS; i++) {
@@ -101,29 +82,20 @@ void test_body_tick() {
     double t = STEPS * DT;
     Vector new_x = vec_multiply(t * t / 2, A);
     shape = body_get_shape(body);
-    assert(vec_isclose(*(Vector *) list_get(shape, 0), vec_add((Vector) {-1, -1}, new_x)));
-    assert(vec_isclose(*(Vector *) list_get(shape, 1), vec_add((Vector) {+1, -1}, new_x)));
-    assert(vec_isclose(*(Vector *) list_get(shape, 2), vec_add((Vector) {+1, +1}, new_x)));
-    assert(vec_isclose(*(Vector *) list_get(shape, 3), vec_add((Vector) {-1, +1}, new_x)));
-    list_free(shape);
+    assert(vec_isclose(polygon_get(shape, 0), vec_add((Vector) {-1, -1}, new_x)));
+    assert(vec_isclose(polygon_get(shape, 1), vec_add((Vector) {+1, -1}, new_x)));
+    assert(vec_isclose(polygon_get(shape, 2), vec_add((Vector) {+1, +1}, new_x)));
+    assert(vec_isclose(polygon_get(shape, 3), vec_add((Vector) {-1, +1}, new_x)));
     body_free(body);
 }
 
 void test_infinite_mass() {
-    List *shape = list_init(10, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = VEC_ZERO;
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {0, +1};
-    list_add(shape, v);
-    Body *body = body_init(shape, INFINITY, (RGBColor) {0, 0, 0});
+    Polygon *shape = polygon_init(10);
+    polygon_add(shape, VEC_ZERO);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {+1, +1});
+    polygon_add(shape, (Vector) {0, +1});
+    Body *body = body_init(shape, INFINITY, (RGBColor) {0, 0, 0}, 1);
     body_set_velocity(body, (Vector) {2, 3});
     assert(body_get_mass(body) == INFINITY);
     body_add_force(body, (Vector) {1, 1});
@@ -136,17 +108,11 @@ void test_infinite_mass() {
 void test_forces() {
     const double MASS = 10;
     const double DT = 0.1;
-    List *shape = list_init(3, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {+1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {0, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, 0};
-    list_add(shape, v);
-    Body *body = body_init(shape, MASS, (RGBColor) {0, 0, 0});
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
+    Body *body = body_init(shape, MASS, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(body, VEC_ZERO);
     Vector old_velocity = {1, -2};
     body_set_velocity(body, old_velocity);
@@ -169,17 +135,11 @@ void test_forces() {
 }
 
 void test_body_remove() {
-    List *shape = list_init(3, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {+1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {0, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, 0};
-    list_add(shape, v);
-    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0});
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
+    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
     assert(!body_is_removed(body));
     body_remove(body);
     assert(body_is_removed(body));
@@ -189,35 +149,23 @@ void test_body_remove() {
 }
 
 void test_body_info() {
-    List *shape = list_init(3, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {+1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {0, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, 0};
-    list_add(shape, v);
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
     int *info = malloc(sizeof(*info));
     *info = 123;
-    Body *body = body_init_with_info(shape, 1, (RGBColor) {0, 0, 0}, info, NULL);
+    Body *body = body_init_with_info(shape, 1, (RGBColor) {0, 0, 0}, info, NULL, 1);
     assert(*(int *) body_get_info(body) == 123);
     body_free(body);
     free(info);
 }
 
 void test_body_info_freer() {
-    List *shape = list_init(3, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {+1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {0, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, 0};
-    list_add(shape, v);
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
     List *info = list_init(3, free);
     int *info_elem = malloc(sizeof(*info_elem));
     *info_elem = 10;
@@ -229,7 +177,7 @@ void test_body_info_freer() {
     *info_elem = 30;
     list_add(info, info_elem);
     Body *body = body_init_with_info(
-        shape, 1, (RGBColor) {0, 0, 0}, info, (FreeFunc) list_free
+        shape, 1, (RGBColor) {0, 0, 0}, info, (FreeFunc) list_free, 1
     );
     assert(*(int *) list_get(body_get_info(body), 0) == 10);
     assert(*(int *) list_get(body_get_info(body), 1) == 20);
@@ -237,6 +185,280 @@ void test_body_info_freer() {
     body_free(body);
 }
 
+void test_body_handle() {
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
+    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
+    BodyHandle handle = body_get_handle(body);
+    assert(body_handle_is_live(handle));
+    assert(body_from_handle(handle) == body);
+    assert(body_from_handle(BODY_HANDLE_NONE) == NULL);
+    // A removed body can still be looked up until it is freed
+    body_remove(body);
+    assert(!body_handle_is_live(handle));
+    assert(body_from_handle(handle) == body);
+    body_free(body);
+    assert(body_from_handle(handle) == NULL);
+
+    // The freed slot is reused, but the old handle stays stale
+    shape = polygon_init(3);
+    polygon_add(shape, (Vector) {+1, 0});
+    polygon_add(shape, (Vector) {0, +1});
+    polygon_add(shape, (Vector) {-1, 0});
+    Body *other = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
+    assert(body_get_handle(other).index == handle.index);
+    assert(body_handle_is_live(body_get_handle(other)));
+    assert(body_from_handle(handle) == NULL);
+    body_free(other);
+}
+
+void test_body_cached_shape() {
+    Polygon *shape = polygon_init(4);
+    polygon_add(shape, (Vector) {0, 0});
+    polygon_add(shape, (Vector) {4, 0});
+    polygon_add(shape, (Vector) {4, 2});
+    polygon_add(shape, (Vector) {0, 2});
+    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
+    assert(isclose(body_get_area(body), 8));
+    assert(vec_isclose(body_get_centroid(body), (Vector) {2, 1}));
+    AABB bounds = body_get_bounds(body);
+    assert(vec_isclose(bounds.min, (Vector) {0, 0}));
+    assert(vec_isclose(bounds.max, (Vector) {4, 2}));
+
+    // Translating moves the cached bounds along with the shape
+    body_set_centroid(body, (Vector) {-1, 3});
+    bounds = body_get_bounds(body);
+    assert(vec_isclose(bounds.min, (Vector) {-3, 2}));
+    assert(vec_isclose(bounds.max, (Vector) {1, 4}));
+    assert(isclose(body_get_area(body), 8));
+
+    // Rotating a quarter turn swaps the width and height
+    body_set_rotation(body, M_PI / 2);
+    bounds = body_get_bounds(body);
+    assert(vec_isclose(bounds.min, (Vector) {-2, 1}));
+    assert(vec_isclose(bounds.max, (Vector) {0, 5}));
+    assert(vec_isclose(body_get_centroid(body), (Vector) {-1, 3}));
+
+    // Replacing the shape recomputes everything
+    Polygon *triangle = polygon_init(3);
+    polygon_add(triangle, (Vector) {0, 0});
+    polygon_add(triangle, (Vector) {3, 0});
+    polygon_add(triangle, (Vector) {0, 3});
+    body_set_shape(body, triangle);
+    assert(isclose(body_get_area(body), 4.5));
+    assert(vec_isclose(body_get_centroid(body), (Vector) {1, 1}));
+    bounds = body_get_bounds(body);
+    assert(vec_isclose(bounds.min, (Vector) {0, 0}));
+    assert(vec_isclose(bounds.max, (Vector) {3, 3}));
+    body_free(body);
+}
+
+void test_body_lazy_shape() {
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {0, 0});
+    polygon_add(shape, (Vector) {3, 0});
+    polygon_add(shape, (Vector) {0, 3});
+    Body *body = body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
+    Polygon *world = body_get_shape(body);
+    body_set_velocity(body, (Vector) {1, -2});
+    for (int i = 0; i < 100; i++) {
+        body_tick(body, 0.5);
+    }
+    // The same polygon is rewritten in place once it is asked for again
+    assert(body_get_shape(body) == world);
+    assert(vec_isclose(body_get_centroid(body), (Vector) {51, -99}));
+    assert(vec_isclose(polygon_get(world, 0), (Vector) {50, -100}));
+    assert(vec_isclose(polygon_get(world, 1), (Vector) {53, -100}));
+    assert(vec_isclose(polygon_get(world, 2), (Vector) {50, -97}));
+    // Applying the body's transform to the origin gives its centroid
+    assert(vec_isclose(transform_apply(body_get_transform(body), VEC_ZERO), (Vector) {51, -99}));
+    body_free(body);
+}
+
+void test_body_shared_prototype() {
+    size_t registered = shape_prototype_count();
+    Body *first = block_init((Vector) {10, 20}, (Vector) {30, 5}, (RGBColor) {0, 0, 0}, 1, false);
+    Body *second = block_init((Vector) {-10, 0}, (Vector) {30, 5}, (RGBColor) {0, 0, 0}, 1, true);
+    Body *other = block_init((Vector) {0, 0}, (Vector) {5, 30}, (RGBColor) {0, 0, 0}, 1, false);
+    // Blocks of the same dimension share one local shape
+    assert(body_get_prototype(first) == body_get_prototype(second));
+    assert(body_get_prototype(first) != body_get_prototype(other));
+    assert(shape_prototype_count() == registered + 2);
+    assert(vec_isclose(body_get_centroid(first), (Vector) {10, 20}));
+    assert(within(SCALAR_EPSILON, fabs(body_get_area(second)), 150));
+    AABB bounds = body_get_bounds(second);
+    assert(vec_isclose(bounds.min, (Vector) {-25, -2.5}));
+    assert(vec_isclose(bounds.max, (Vector) {5, 2.5}));
+    assert(vec_isclose(polygon_get(body_get_shape(first), 0), (Vector) {25, 22.5}));
+    assert(vec_isclose(polygon_get(body_get_shape(second), 0), (Vector) {5, 2.5}));
+
+    // Resizing a star only swaps prototypes; the old size stays registered
+    // while something still holds it
+    Body *star = player_init(5, (Vector) {1, 1}, 4, 1, (RGBColor) {0, 0, 0}, 1);
+    ShapePrototype *small = shape_prototype_retain(body_get_prototype(star));
+    body_star_set_radius_draw(star, 4, 5);
+    assert(body_get_prototype(star) == small);
+    body_star_set_radius_draw(star, 8, 5);
+    assert(body_get_prototype(star) != small);
+    assert(within(SCALAR_EPSILON, body_get_area(star), 4 * shape_prototype_get_area(small)));
+    assert(vec_isclose(body_get_centroid(star), (Vector) {1, 1}));
+    assert(shape_prototype_count() == registered + 4);
+    // Sizes no body uses any more leave the registry
+    shape_prototype_release(small);
+    assert(shape_prototype_count() == registered + 3);
+    body_free(first);
+    assert(shape_prototype_count() == registered + 3);
+    body_free(second);
+    assert(shape_prototype_count() == registered + 2);
+
+    // Many sizes, each used by one body at a time, never pile up
+    for (size_t i = 1; i <= 100; i++) {
+        body_star_set_radius_draw(star, i, 5);
+    }
+    assert(shape_prototype_count() == registered + 2);
+
+    body_free(other);
+    body_free(star);
+    assert(shape_prototype_count() == registered);
+    shape_prototype_clear();
+    assert(shape_prototype_count() == 0);
+}
+
+void test_body_lod() {
+    Body *ball = point_init((Vector) {5, 5}, 3, 1, (RGBColor) {0, 0, 0}, 1);
+    ShapePrototype *prototype = body_get_prototype(ball);
+    size_t full = polygon_size(body_get_shape(ball));
+
+    // Collisions are checked against fewer vertices, placed at the centroid
+    Polygon *collision = body_get_collision_shape(ball);
+    assert(polygon_size(collision) < full);
+    assert(polygon_size(collision) == polygon_size(shape_prototype_get_collision_lod(prototype)));
+    assert(vec_within(0.05, polygon_centroid(collision), (Vector) {5, 5}));
+    body_set_centroid(ball, (Vector) {-5, 0});
+    assert(body_get_collision_shape(ball) == collision);
+    assert(vec_within(0.05, polygon_centroid(collision), (Vector) {-5, 0}));
+
+    // Fewer vertices are drawn the smaller the ball is on screen
+    size_t large = polygon_size(shape_prototype_get_render_lod(prototype, 1000));
+    size_t medium = polygon_size(shape_prototype_get_render_lod(prototype, 2));
+    size_t small = polygon_size(shape_prototype_get_render_lod(prototype, 0.1));
+    assert(large == full);
+    assert(medium < large);
+    assert(small < medium);
+
+    // Shapes with nothing to simplify are checked in full
+    Body *block = block_init(VEC_ZERO, (Vector) {30, 5}, (RGBColor) {0, 0, 0}, 1, false);
+    assert(body_get_collision_shape(block) == body_get_shape(block));
+
+    body_free(ball);
+    body_free(block);
+    shape_prototype_clear();
+}
+
+void test_body_axes() {
+    Body *block = block_init((Vector) {3, 4}, (Vector) {6, 2}, (RGBColor) {0, 0, 0}, 1, false);
+    size_t count;
+    Vector *axes = body_get_axes(block, &count);
+    // Unrotated bodies use their prototype's axes as they are
+    size_t shared_count;
+    assert(axes == shape_prototype_get_axes(body_get_prototype(block), &shared_count));
+    assert(count == 2 && shared_count == 2);
+
+    // Rotating turns the axes instead of recomputing them from the vertices
+    body_set_rotation(block, M_PI / 2);
+    axes = body_get_axes(block, &count);
+    assert(count == 2);
+    for (size_t i = 0; i < count; i++) {
+        assert(within(SCALAR_EPSILON, fabs(vec_cross(axes[i], (Vector) {1, 0})) +
+            fabs(vec_cross(axes[i], (Vector) {0, 1})), 1));
+        assert(isclose(vec_dot(axes[i], axes[i]), 1));
+    }
+    Polygon *shape = body_get_shape(block);
+    Vector edge = vec_subtract(polygon_get(shape, 1), polygon_get(shape, 0));
+    assert(within(SCALAR_EPSILON, vec_dot(edge, axes[0]), 0));
+    // Moving keeps them
+    body_set_centroid(block, VEC_ZERO);
+    assert(body_get_axes(block, &count) == axes);
+
+    body_free(block);
+    shape_prototype_clear();
+}
+
+void test_star_pieces() {
+    ShapePrototype *star = shape_prototype_star(5, 10);
+    size_t count;
+    ShapePiece *pieces = shape_prototype_get_pieces(star, &count);
+    // One convex kite per point, which together cover the star exactly
+    assert(count == 5);
+    Scalar area = 0;
+    for (size_t i = 0; i < count; i++) {
+        assert(polygon_size(pieces[i].shape) == 4);
+        assert(polygon_is_convex(pieces[i].shape));
+        for (size_t j = 0; j < polygon_size(pieces[i].shape); j++) {
+            Vector from_center = vec_subtract(polygon_get(pieces[i].shape, j), pieces[i].center);
+            assert(vec_magnitude(from_center) <= pieces[i].radius + SCALAR_EPSILON);
+        }
+        area += polygon_area(pieces[i].shape);
+    }
+    assert(isclose(area, shape_prototype_get_area(star)));
+    assert(!polygon_is_convex(shape_prototype_get_polygon(star)));
+
+    // A convex shape is its own single piece
+    ShapePrototype *block = shape_prototype_block((Vector) {6, 2});
+    pieces = shape_prototype_get_pieces(block, &count);
+    assert(count == 1 && pieces[0].shape == shape_prototype_get_collision_lod(block));
+
+    shape_prototype_release(star);
+    shape_prototype_release(block);
+    shape_prototype_clear();
+}
+
+void test_body_contacts() {
+    Body *body = body_init(create_block(VEC_ZERO, (Vector) {2, 2}), 1, (RGBColor) {0, 0, 0}, 1);
+    Body *floor = body_init(create_block(VEC_ZERO, (Vector) {2, 2}), 1, (RGBColor) {0, 0, 0}, 1);
+    Body *wall = body_init(create_block(VEC_ZERO, (Vector) {2, 2}), 1, (RGBColor) {0, 0, 0}, 1);
+    size_t count;
+    body_get_contacts(body, &count);
+    assert(count == 0 && !body_is_grounded(body));
+
+    // A contact to the side does not hold the body up
+    body_set_contact(body, body_get_handle(wall), (Vector) {1, 0});
+    assert(!body_is_grounded(body));
+    body_set_contact(body, body_get_handle(floor), (Vector) {0, -1});
+    assert(body_is_grounded(body));
+    // Setting a contact again only updates its normal
+    body_set_contact(body, body_get_handle(floor), (Vector) {M_SQRT1_2, -M_SQRT1_2});
+    Contact *contacts = body_get_contacts(body, &count);
+    assert(count == 2 && body_is_grounded(body));
+    assert(body_handle_equal(contacts[1].other, body_get_handle(floor)));
+    assert(vec_isclose(contacts[1].normal, (Vector) {M_SQRT1_2, -M_SQRT1_2}));
+
+    body_clear_contact(body, body_get_handle(floor));
+    contacts = body_get_contacts(body, &count);
+    assert(count == 1 && body_handle_equal(contacts[0].other, body_get_handle(wall)));
+    assert(!body_is_grounded(body));
+
+    // A body that reuses a freed body's slot is a different contact
+    BodyHandle gone = body_get_handle(floor);
+    body_set_contact(body, gone, (Vector) {0, -1});
+    body_free(floor);
+    floor = body_init(create_block(VEC_ZERO, (Vector) {2, 2}), 1, (RGBColor) {0, 0, 0}, 1);
+    assert(body_get_handle(floor).index == gone.index);
+    assert(!body_handle_equal(body_get_handle(floor), gone));
+    body_set_contact(body, body_get_handle(floor), (Vector) {1, 0});
+    contacts = body_get_contacts(body, &count);
+    assert(count == 3 && body_handle_equal(contacts[1].other, gone));
+    assert(vec_isclose(contacts[1].normal, (Vector) {0, -1}));
+    body_clear_contact(body, body_get_handle(floor));
+    contacts = body_get_contacts(body, &count);
+    assert(count == 2 && body_handle_equal(contacts[1].other, gone));
+    body_free(body);
+    body_free(floor);
+    body_free(wall);
+}
+
 int main(int argc, char *argv[]) {
     // Run all tests if there are no command-line arguments
     bool all_tests = argc == 1;
@@ -254,6 +476,14 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_body_remove)
     DO_TEST(test_body_info)
     DO_TEST(test_body_info_freer)
+    DO_TEST(test_body_handle)
+    DO_TEST(test_body_cached_shape)
+    DO_TEST(test_body_lazy_shape)
+    DO_TEST(test_body_shared_prototype)
+    DO_TEST(test_body_lod)
+    DO_TEST(test_body_axes)
+    DO_TEST(test_star_pieces)
+    DO_TEST(test_body_contacts)
 
     puts("body_test PASS");
     return 0;
@@ -0,0 +1,265 @@
+#include "test_util.h"
+#include "broad_phase.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BOX_COUNT 200
+
+// Records every pair found, as a matrix indexed by the pair's ids
+typedef struct pair_record {
+    bool found[BOX_COUNT][BOX_COUNT];
+    size_t count;
+} PairRecord;
+
+void record_pair(size_t id1, size_t id2, void *aux) {
+    PairRecord *record = aux;
+    assert(id1 < id2);
+    // Each pair is found only once
+    assert(!record->found[id1][id2]);
+    record->found[id1][id2] = true;
+    record->count++;
+}
+
+// Scatters boxes of mixed sizes, a few of them far larger than any cell
+void make_boxes(AABB *boxes, size_t count) {
+    srand(3);
+    for (size_t i = 0; i < count; i++) {
+        Vector min = {rand() % 400 - 200, rand() % 200 - 100};
+        Vector size = {1 + rand() % 30, 1 + rand() % 30};
+        if (i % 50 == 0) {
+            size = (Vector) {400, 10};
+        }
+        boxes[i] = (AABB) {min, vec_add(min, size)};
+    }
+}
+
+// Finds the pairs among boxes with keys, then again after removing the box
+// at index removed, and checks the second call against every pair.
+// Returns the broad phase's statistics for the second call.
+BroadPhaseStats check_remove_middle(BroadPhaseKind kind, size_t removed) {
+    AABB boxes[BOX_COUNT];
+    size_t keys[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        keys[i] = i;
+    }
+    PairRecord *expected = calloc(1, sizeof(PairRecord));
+    PairRecord *actual = calloc(1, sizeof(PairRecord));
+    BroadPhase *all_pairs = broad_phase_init(BROAD_PHASE_ALL_PAIRS);
+    BroadPhase *broad_phase = broad_phase_init(kind);
+    broad_phase_find_pairs(broad_phase, boxes, keys, BOX_COUNT, record_pair, actual);
+
+    // Every box after the removed one gets a new id but keeps its key
+    size_t after = BOX_COUNT - removed - 1;
+    memmove(&boxes[removed], &boxes[removed + 1], after * sizeof(AABB));
+    memmove(&keys[removed], &keys[removed + 1], after * sizeof(size_t));
+    memset(actual, 0, sizeof(PairRecord));
+    size_t count = broad_phase_find_pairs(broad_phase, boxes, keys, BOX_COUNT - 1, record_pair, actual);
+    BroadPhaseStats stats = broad_phase_get_stats(broad_phase);
+    assert(count == broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT - 1, record_pair, expected));
+    assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+
+    broad_phase_free(all_pairs);
+    broad_phase_free(broad_phase);
+    free(expected);
+    free(actual);
+    return stats;
+}
+
+void check_matches_all_pairs(BroadPhaseKind kind, Scalar cell_size) {
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    PairRecord *expected = calloc(1, sizeof(PairRecord));
+    PairRecord *actual = calloc(1, sizeof(PairRecord));
+    BroadPhase *all_pairs = broad_phase_init(BROAD_PHASE_ALL_PAIRS);
+    BroadPhase *broad_phase = broad_phase_init(kind);
+    broad_phase_set_cell_size(broad_phase, cell_size);
+
+    size_t count = broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT, record_pair, expected);
+    assert(count == expected->count && count > 0);
+    // Running twice reuses the broad phase's memory and finds the same pairs
+    for (size_t run = 0; run < 2; run++) {
+        memset(actual, 0, sizeof(PairRecord));
+        assert(broad_phase_find_pairs(broad_phase, boxes, NULL, BOX_COUNT, record_pair, actual) == count);
+        assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+    }
+
+    broad_phase_free(all_pairs);
+    broad_phase_free(broad_phase);
+    free(expected);
+    free(actual);
+}
+
+void test_grid_matches_all_pairs() {
+    check_matches_all_pairs(BROAD_PHASE_GRID, BROAD_PHASE_DEFAULT_CELL_SIZE);
+    // Cells much smaller than the boxes send most of them down the slow path
+    check_matches_all_pairs(BROAD_PHASE_GRID, 2);
+    check_matches_all_pairs(BROAD_PHASE_GRID, 1000);
+}
+
+void test_grid_touching() {
+    // Boxes that share only an edge on a cell boundary still overlap
+    AABB boxes[] = {
+        {{0, 0}, {25, 25}},
+        {{25, 0}, {50, 25}},
+        {{-10, -10}, {-5, -5}}
+    };
+    PairRecord *record = calloc(1, sizeof(PairRecord));
+    BroadPhase *broad_phase = broad_phase_init(BROAD_PHASE_GRID);
+    assert(broad_phase_get_kind(broad_phase) == BROAD_PHASE_GRID);
+    assert(broad_phase_get_cell_size(broad_phase) == BROAD_PHASE_DEFAULT_CELL_SIZE);
+    assert(broad_phase_find_pairs(broad_phase, boxes, NULL, 3, record_pair, record) == 1);
+    assert(record->found[0][1]);
+    broad_phase_free(broad_phase);
+    free(record);
+}
+
+void test_no_boxes() {
+    // Every kind of broad phase handles an empty set of boxes, before and
+    // after it has seen some
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    PairRecord *record = calloc(1, sizeof(PairRecord));
+    BroadPhaseKind kinds[] = {BROAD_PHASE_ALL_PAIRS, BROAD_PHASE_GRID, BROAD_PHASE_SWEEP, BROAD_PHASE_TREE};
+    for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); k++) {
+        BroadPhase *broad_phase = broad_phase_init(kinds[k]);
+        assert(broad_phase_find_pairs(broad_phase, boxes, NULL, 0, record_pair, record) == 0);
+        assert(broad_phase_get_stats(broad_phase).tests == 0);
+        broad_phase_find_pairs(broad_phase, boxes, NULL, BOX_COUNT, record_pair, record);
+        memset(record, 0, sizeof(PairRecord));
+        assert(broad_phase_find_pairs(broad_phase, boxes, NULL, 0, record_pair, record) == 0);
+        assert(record->count == 0);
+        broad_phase_free(broad_phase);
+    }
+    free(record);
+}
+
+void test_grid_all_oversized() {
+    // Cells far smaller than every box leave the grid itself empty, so every
+    // pair is compared through the oversized path
+    check_matches_all_pairs(BROAD_PHASE_GRID, 0.01);
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    PairRecord *record = calloc(1, sizeof(PairRecord));
+    BroadPhase *broad_phase = broad_phase_init(BROAD_PHASE_GRID);
+    broad_phase_set_cell_size(broad_phase, 0.01);
+    broad_phase_find_pairs(broad_phase, boxes, NULL, BOX_COUNT, record_pair, record);
+    assert(broad_phase_get_stats(broad_phase).tests == BOX_COUNT * (BOX_COUNT - 1) / 2);
+    broad_phase_free(broad_phase);
+    free(record);
+}
+
+void test_sweep_matches_all_pairs() {
+    check_matches_all_pairs(BROAD_PHASE_SWEEP, BROAD_PHASE_DEFAULT_CELL_SIZE);
+}
+
+void test_tree_matches_all_pairs() {
+    check_matches_all_pairs(BROAD_PHASE_TREE, BROAD_PHASE_DEFAULT_CELL_SIZE);
+}
+
+void test_sweep_persistent() {
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    PairRecord *expected = calloc(1, sizeof(PairRecord));
+    PairRecord *actual = calloc(1, sizeof(PairRecord));
+    BroadPhase *all_pairs = broad_phase_init(BROAD_PHASE_ALL_PAIRS);
+    BroadPhase *sweep = broad_phase_init(BROAD_PHASE_SWEEP);
+
+    broad_phase_find_pairs(sweep, boxes, NULL, BOX_COUNT, record_pair, actual);
+    BroadPhaseStats first = broad_phase_get_stats(sweep);
+    assert(first.boxes == BOX_COUNT && first.pairs == actual->count);
+    // Far fewer pairs are compared than there are pairs of boxes
+    assert(first.tests < BOX_COUNT * (BOX_COUNT - 1) / 4);
+
+    // After a small move, the boxes are sorted again with few swaps
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        Vector move = {(i % 3) * 0.1, -0.2};
+        boxes[i] = (AABB) {vec_add(boxes[i].min, move), vec_add(boxes[i].max, move)};
+    }
+    memset(actual, 0, sizeof(PairRecord));
+    size_t count = broad_phase_find_pairs(sweep, boxes, NULL, BOX_COUNT, record_pair, actual);
+    assert(broad_phase_get_stats(sweep).swaps < first.swaps / 4);
+    assert(count == broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT, record_pair, expected));
+    assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+
+    // Dropping boxes from the end and adding them back keeps it correct
+    memset(actual, 0, sizeof(PairRecord));
+    memset(expected, 0, sizeof(PairRecord));
+    broad_phase_find_pairs(sweep, boxes, NULL, BOX_COUNT / 2, record_pair, actual);
+    broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT / 2, record_pair, expected);
+    assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+    memset(actual, 0, sizeof(PairRecord));
+    memset(expected, 0, sizeof(PairRecord));
+    broad_phase_find_pairs(sweep, boxes, NULL, BOX_COUNT, record_pair, actual);
+    broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT, record_pair, expected);
+    assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+
+    // Removing a box from the middle leaves the rest sorted
+    assert(check_remove_middle(BROAD_PHASE_SWEEP, BOX_COUNT / 3).swaps == 0);
+
+    broad_phase_free(all_pairs);
+    broad_phase_free(sweep);
+    free(expected);
+    free(actual);
+}
+
+void test_tree_persistent() {
+    AABB boxes[BOX_COUNT];
+    make_boxes(boxes, BOX_COUNT);
+    PairRecord *expected = calloc(1, sizeof(PairRecord));
+    PairRecord *actual = calloc(1, sizeof(PairRecord));
+    BroadPhase *all_pairs = broad_phase_init(BROAD_PHASE_ALL_PAIRS);
+    BroadPhase *tree = broad_phase_init(BROAD_PHASE_TREE);
+    broad_phase_find_pairs(tree, boxes, NULL, BOX_COUNT, record_pair, actual);
+    assert(broad_phase_get_stats(tree).tests < BOX_COUNT * (BOX_COUNT - 1) / 4);
+
+    // Boxes that stay within the margin are not reinserted
+    for (size_t i = 0; i < BOX_COUNT; i++) {
+        Vector move = {i % 10 == 0 ? 5 : 0.1, 0};
+        boxes[i] = (AABB) {vec_add(boxes[i].min, move), vec_add(boxes[i].max, move)};
+    }
+    memset(actual, 0, sizeof(PairRecord));
+    size_t count = broad_phase_find_pairs(tree, boxes, NULL, BOX_COUNT, record_pair, actual);
+    assert(broad_phase_get_stats(tree).swaps == BOX_COUNT / 10);
+    assert(count == broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT, record_pair, expected));
+    assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+
+    // Dropping boxes from the end removes them from the tree
+    memset(actual, 0, sizeof(PairRecord));
+    memset(expected, 0, sizeof(PairRecord));
+    broad_phase_find_pairs(tree, boxes, NULL, BOX_COUNT / 3, record_pair, actual);
+    broad_phase_find_pairs(all_pairs, boxes, NULL, BOX_COUNT / 3, record_pair, expected);
+    assert(memcmp(expected->found, actual->found, sizeof(expected->found)) == 0);
+
+    // Removing a box from the middle moves none of the others in the tree
+    assert(check_remove_middle(BROAD_PHASE_TREE, BOX_COUNT / 3).swaps == 0);
+
+    broad_phase_free(all_pairs);
+    broad_phase_free(tree);
+    free(expected);
+    free(actual);
+}
+
+int main(int argc, char *argv[]) {
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_grid_matches_all_pairs)
+    DO_TEST(test_grid_touching)
+    DO_TEST(test_no_boxes)
+    DO_TEST(test_grid_all_oversized)
+    DO_TEST(test_sweep_matches_all_pairs)
+    DO_TEST(test_sweep_persistent)
+    DO_TEST(test_tree_matches_all_pairs)
+    DO_TEST(test_tree_persistent)
+
+    puts("broad_phase_test PASS");
+
+    return 0;
+}
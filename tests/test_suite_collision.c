@@ -1,8 +1,9 @@
 #include "vector.h"
 #include "test_util.h"
-#include "list.h"
+#include "polygon.h"
 #include "forces.h"
 #include "collision.h"
+#include "shape.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -12,21 +13,16 @@ void test_collision() {
     Vector v[] = {{1, 1}, {3, 1}, {3, 3}, {1, 3}};
     Vector v2[] = {{2, 2}, {4, 2}, {4, 4}, {2, 4}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(1, free);
-    List *shape2 = list_init(1, free);
+    Polygon *shape = polygon_init(VERTICES);
+    Polygon *shape2 = polygon_init(VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
-
-        Vector *list_v2 = malloc(sizeof(*list_v2));
-        *list_v2 = v2[i];
-        list_add(shape2, list_v2);
+        polygon_add(shape, v[i]);
+        polygon_add(shape2, v2[i]);
     }
-    assert(find_collision(shape, shape2));
-    assert(find_collision(shape2, shape));
-    list_free(shape);
-    list_free(shape2);
+    assert(find_collision(shape, shape2).collided);
+    assert(find_collision(shape2, shape).collided);
+    polygon_free(shape);
+    polygon_free(shape2);
     return;
 }
 
@@ -34,21 +30,16 @@ void test_no_collision() {
     Vector v[] = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
     Vector v2[] = {{5, 5}, {6, 5}, {6, 6}, {5, 6}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(1, free);
-    List *shape2 = list_init(1, free);
+    Polygon *shape = polygon_init(VERTICES);
+    Polygon *shape2 = polygon_init(VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
-
-        Vector *list_v2 = malloc(sizeof(*list_v2));
-        *list_v2 = v2[i];
-        list_add(shape2, list_v2);
+        polygon_add(shape, v[i]);
+        polygon_add(shape2, v2[i]);
     }
-    assert(!find_collision(shape, shape2));
-    assert(!find_collision(shape2, shape));
-    list_free(shape);
-    list_free(shape2);
+    assert(!find_collision(shape, shape2).collided);
+    assert(!find_collision(shape2, shape).collided);
+    polygon_free(shape);
+    polygon_free(shape2);
     return;
 }
 
@@ -57,21 +48,16 @@ void test_border_collision() {
     Vector v[] = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
     Vector v2[] = {{2, 1}, {3, 1}, {3, 2}, {2, 2}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(1, free);
-    List *shape2 = list_init(1, free);
+    Polygon *shape = polygon_init(VERTICES);
+    Polygon *shape2 = polygon_init(VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
-
-        Vector *list_v2 = malloc(sizeof(*list_v2));
-        *list_v2 = v2[i];
-        list_add(shape2, list_v2);
+        polygon_add(shape, v[i]);
+        polygon_add(shape2, v2[i]);
     }
-    assert(find_collision(shape, shape2));
-    assert(find_collision(shape2, shape));
-    list_free(shape);
-    list_free(shape2);
+    assert(find_collision(shape, shape2).collided);
+    assert(find_collision(shape2, shape).collided);
+    polygon_free(shape);
+    polygon_free(shape2);
     return;
 }
 
@@ -80,21 +66,16 @@ void test_corner_collision() {
     Vector v[] = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
     Vector v2[] = {{2, 2}, {3, 2}, {3, 3}, {2, 3}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(1, free);
-    List *shape2 = list_init(1, free);
+    Polygon *shape = polygon_init(VERTICES);
+    Polygon *shape2 = polygon_init(VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
-
-        Vector *list_v2 = malloc(sizeof(*list_v2));
-        *list_v2 = v2[i];
-        list_add(shape2, list_v2);
+        polygon_add(shape, v[i]);
+        polygon_add(shape2, v2[i]);
     }
-    assert(find_collision(shape, shape2));
-    assert(find_collision(shape2, shape));
-    list_free(shape);
-    list_free(shape2);
+    assert(find_collision(shape, shape2).collided);
+    assert(find_collision(shape2, shape).collided);
+    polygon_free(shape);
+    polygon_free(shape2);
     return;
 }
 
@@ -103,21 +84,16 @@ void test_inside_collision() {
     Vector v[] = {{1, 1}, {6, 1}, {6, 6}, {1, 6}};
     Vector v2[] = {{2, 2}, {3, 2}, {3, 3}, {2, 3}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(1, free);
-    List *shape2 = list_init(1, free);
+    Polygon *shape = polygon_init(VERTICES);
+    Polygon *shape2 = polygon_init(VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
-
-        Vector *list_v2 = malloc(sizeof(*list_v2));
-        *list_v2 = v2[i];
-        list_add(shape2, list_v2);
+        polygon_add(shape, v[i]);
+        polygon_add(shape2, v2[i]);
     }
-    assert(find_collision(shape, shape2));
-    assert(find_collision(shape2, shape));
-    list_free(shape);
-    list_free(shape2);
+    assert(find_collision(shape, shape2).collided);
+    assert(find_collision(shape2, shape).collided);
+    polygon_free(shape);
+    polygon_free(shape2);
     return;
 }
 
@@ -125,17 +101,337 @@ void test_same_collision() {
     //Assumed 'yes' for same object collision
     Vector v[] = {{1, 1}, {6, 1}, {6, 6}, {1, 6}};
     const size_t VERTICES = sizeof(v) / sizeof(*v);
-    List *shape = list_init(1, free);
+    Polygon *shape = polygon_init(VERTICES);
     for (size_t i = 0; i < VERTICES; i++) {
-        Vector *list_v = malloc(sizeof(*list_v));
-        *list_v = v[i];
-        list_add(shape, list_v);
+        polygon_add(shape, v[i]);
     }
-    assert(find_collision(shape, shape));
-    list_free(shape);
+    assert(find_collision(shape, shape).collided);
+    polygon_free(shape);
     return;
 }
 
+void test_circle_collision() {
+    CollisionInfo info = find_circle_collision((Vector) {0, 0}, 2, (Vector) {3, 0}, 2);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {1, 0}));
+    assert(isclose(info.overlap, 1));
+    info = find_circle_collision((Vector) {0, 0}, 2, (Vector) {3, 4}, 2);
+    assert(!info.collided);
+    // Touching counts as colliding, like the polygon check
+    assert(find_circle_collision((Vector) {0, 0}, 2, (Vector) {0, -4}, 2).collided);
+}
+
+void test_circle_polygon_collision() {
+    // Clockwise, like create_block()
+    Vector v[] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+    const size_t VERTICES = sizeof(v) / sizeof(*v);
+    Polygon *square = polygon_init(VERTICES);
+    for (size_t i = 0; i < VERTICES; i++) {
+        polygon_add(square, v[i]);
+    }
+    // Against a side, the axis points from the circle into the square
+    CollisionInfo info = find_circle_polygon_collision((Vector) {0, 1.5}, 1, square);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {0, -1}));
+    assert(isclose(info.overlap, 0.5));
+    // Near a corner, but out of reach of it
+    assert(!find_circle_polygon_collision((Vector) {1.8, 1.8}, 1, square).collided);
+    info = find_circle_polygon_collision((Vector) {1.5, 1.5}, 1, square);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {-sqrt(0.5), -sqrt(0.5)}));
+    // With the center inside, the axis still points out of the nearest side
+    info = find_circle_polygon_collision((Vector) {0.75, 0}, 0.5, square);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {-1, 0}));
+    assert(isclose(info.overlap, 0.75));
+    polygon_free(square);
+}
+
+void test_body_circle_collision() {
+    Body *ball1 = point_init((Vector) {0, 0}, 2, 1, (RGBColor) {0, 0, 0}, 1);
+    Body *ball2 = point_init((Vector) {3.9, 0}, 2, 1, (RGBColor) {0, 0, 0}, 1);
+    Body *block = block_init((Vector) {0, -3}, (Vector) {10, 2}, (RGBColor) {0, 0, 0}, 1, false);
+    assert(body_is_circle(ball1) && !body_is_circle(block));
+
+    CollisionInfo info = find_body_collision(ball1, ball2);
+    assert(info.collided);
+    assert(vec_within(1e-3, info.axis, (Vector) {1, 0}));
+    // The axis points from the first body towards the second either way round
+    body_set_centroid(ball1, (Vector) {0, -0.1});
+    assert(vec_isclose(find_body_collision(ball1, block).axis, (Vector) {0, -1}));
+    assert(vec_isclose(find_body_collision(block, ball1).axis, (Vector) {0, 1}));
+    body_set_centroid(ball1, (Vector) {0, 0.1});
+    assert(!find_body_collision(ball1, block).collided);
+
+    body_free(ball1);
+    body_free(ball2);
+    body_free(block);
+    shape_prototype_clear();
+}
+
+void test_box_collision() {
+    AABB box = {{0, 0}, {4, 2}};
+    CollisionInfo info = find_box_collision(box, (AABB) {{3, 1}, {6, 5}});
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {0, 1}));
+    assert(isclose(info.overlap, 1));
+    info = find_box_collision((AABB) {{3.5, -1}, {6, 1}}, box);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {-1, 0}));
+    assert(isclose(info.overlap, 0.5));
+    assert(!find_box_collision(box, (AABB) {{4.5, 0}, {5, 1}}).collided);
+}
+
+void test_box_polygon_collision() {
+    AABB box = {{-1, -1}, {1, 1}};
+    // A diamond whose bounds overlap the box's corner, but which does not
+    Vector v[] = {{2.75, 1.75}, {1.75, 2.75}, {0.75, 1.75}, {1.75, 0.75}};
+    const size_t VERTICES = sizeof(v) / sizeof(*v);
+    Polygon *diamond = polygon_init(VERTICES);
+    for (size_t i = 0; i < VERTICES; i++) {
+        polygon_add(diamond, v[i]);
+    }
+    Vector axes[VERTICES];
+    size_t count = polygon_edge_normals(diamond, axes);
+    assert(count == 2);
+    assert(!find_box_polygon_collision(box, diamond, axes, count).collided);
+    // Moved onto the corner, the diamond is pushed away along its own normal
+    polygon_translate(diamond, (Vector) {-0.4, -0.4});
+    CollisionInfo info = find_box_polygon_collision(box, diamond, axes, count);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {sqrt(0.5), sqrt(0.5)}));
+    assert(isclose(info.overlap, 0.15 * sqrt(2)));
+    polygon_free(diamond);
+}
+
+void test_circle_box_collision() {
+    AABB box = {{-1, -1}, {1, 1}};
+    CollisionInfo info = find_circle_box_collision((Vector) {1.5, 0}, 1, box);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {-1, 0}));
+    assert(isclose(info.overlap, 0.5));
+    assert(!find_circle_box_collision((Vector) {1.8, 1.8}, 1, box).collided);
+    info = find_circle_box_collision((Vector) {0, -0.75}, 0.5, box);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {0, 1}));
+    assert(isclose(info.overlap, 0.75));
+}
+
+void test_body_box_collision() {
+    Body *platform = block_init((Vector) {0, 0}, (Vector) {30, 5}, (RGBColor) {0, 0, 0}, 1, false);
+    Body *wall = boundary_init((Vector) {16, 0}, (Vector) {5, 20}, (RGBColor) {0, 0, 0}, 1);
+    Body *star = player_init(5, (Vector) {0, 3}, 1, 1, (RGBColor) {0, 0, 0}, 1);
+    assert(body_is_box(platform) && body_is_box(wall) && !body_is_box(star));
+
+    CollisionInfo info = find_body_collision(wall, platform);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {-1, 0}));
+    info = find_body_collision(star, platform);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {0, -1}));
+    body_set_centroid(star, (Vector) {0, 4});
+    assert(!find_body_collision(star, platform).collided);
+
+    // Blocks made by create_block() are recognised too, until rotated
+    Body *block = body_init(create_block((Vector) {0, 20}, (Vector) {2, 2}), 1, (RGBColor) {0, 0, 0}, 1);
+    assert(body_is_box(block));
+    body_set_rotation(block, M_PI / 4);
+    assert(!body_is_box(block));
+
+    body_free(platform);
+    body_free(wall);
+    body_free(star);
+    body_free(block);
+    shape_prototype_clear();
+}
+
+void test_separating_axis_cache() {
+    // Two triangles whose bounding boxes overlap, but which do not touch
+    Polygon *shape1 = polygon_init(3);
+    polygon_add(shape1, (Vector) {0, 0});
+    polygon_add(shape1, (Vector) {4, 0});
+    polygon_add(shape1, (Vector) {0, 4});
+    Polygon *shape2 = polygon_init(3);
+    polygon_add(shape2, (Vector) {2.5, 2.5});
+    polygon_add(shape2, (Vector) {4, 2.5});
+    polygon_add(shape2, (Vector) {2.5, 4});
+    Body *triangle1 = body_init(shape1, 1, (RGBColor) {0, 0, 0}, 1);
+    Body *triangle2 = body_init(shape2, 1, (RGBColor) {0, 0, 0}, 1);
+    assert(aabb_overlap(body_get_bounds(triangle1), body_get_bounds(triangle2)));
+    assert(!find_body_collision(triangle1, triangle2).collided);
+
+    separating_axis_reset_stats();
+    SeparatingAxisCache cache = SEPARATING_AXIS_CACHE_EMPTY;
+    CollisionInfo info = find_body_collision_cached(triangle1, triangle2, &cache, NARROW_PHASE_AUTO);
+    assert(!info.collided);
+    assert(cache.valid);
+    SeparatingAxisStats stats = separating_axis_get_stats();
+    assert(stats.lookups == 0 && stats.full_checks == 1);
+
+    // A small move keeps the same axis separating them
+    body_set_centroid(triangle2, vec_add(body_get_centroid(triangle2), (Vector) {0.5, 0}));
+    assert(!find_body_collision_cached(triangle1, triangle2, &cache, NARROW_PHASE_AUTO).collided);
+    stats = separating_axis_get_stats();
+    assert(stats.lookups == 1 && stats.hits == 1 && stats.full_checks == 1);
+
+    // Once they touch, the full check runs and the cache is emptied
+    body_set_centroid(triangle2, (Vector) {1.5, 1.5});
+    assert(find_body_collision_cached(triangle1, triangle2, &cache, NARROW_PHASE_AUTO).collided);
+    assert(!cache.valid);
+    stats = separating_axis_get_stats();
+    assert(stats.lookups == 2 && stats.hits == 1 && stats.full_checks == 2);
+
+    body_free(triangle1);
+    body_free(triangle2);
+    shape_prototype_clear();
+}
+
+void test_star_piece_collision() {
+    RGBColor color = {0, 0, 0};
+    Body *star = star_init(5, (Vector) {0, 0}, 10, 1, color, 1, SPIKE);
+    // The notch between two points, inside the star's convex hull
+    Vector notch = vec_rotate((Vector) {0, 1}, M_PI / 5);
+    Body *ball = point_init(vec_multiply(7, notch), 1.5, 1, color, 1);
+    assert(find_collision(body_get_shape(star), body_get_shape(ball)).collided);
+    assert(!find_body_collision(star, ball).collided);
+    assert(!find_body_collision(ball, star).collided);
+
+    // Further in, it touches the edges on either side of the notch
+    body_set_centroid(ball, vec_multiply(6, notch));
+    CollisionInfo info = find_body_collision(star, ball);
+    assert(info.collided);
+    assert(vec_dot(info.axis, notch) > 0);
+    assert(vec_isclose(find_body_collision(ball, star).axis, vec_negate(info.axis)));
+
+    // Polygons and rotated stars are checked in the star's frame
+    Body *block = block_init(vec_multiply(7, notch), (Vector) {1, 1}, color, 1, false);
+    assert(!find_body_collision(star, block).collided);
+    body_set_rotation(star, M_PI / 5);
+    assert(find_body_collision(star, block).collided);
+    Body *other = star_init(5, vec_multiply(16, notch), 10, 1, color, 1, POINT);
+    assert(find_body_collision(star, other).collided);
+    body_set_rotation(star, 0);
+    assert(!find_body_collision(star, other).collided);
+
+    body_free(star);
+    body_free(ball);
+    body_free(block);
+    body_free(other);
+    shape_prototype_clear();
+}
+
+// Makes a regular polygon with the given number of vertices
+Polygon *make_regular(size_t sides, Vector center, double radius) {
+    Polygon *shape = polygon_init(sides);
+    for (size_t i = 0; i < sides; i++) {
+        double angle = 2 * M_PI * i / sides;
+        polygon_add(shape, vec_add(center, (Vector) {radius * cos(angle), radius * sin(angle)}));
+    }
+    return shape;
+}
+
+void test_gjk_collision() {
+    Polygon *circle1 = make_regular(64, (Vector) {0, 0}, 1);
+    Polygon *circle2 = make_regular(64, (Vector) {1.5, 0}, 1);
+    CollisionInfo info = find_gjk_collision(circle1, circle2);
+    assert(info.collided);
+    // The difference of two 64-gons has an edge every pi / 64 radians
+    assert(vec_within(0.05, info.axis, (Vector) {1, 0}));
+    assert(within(1e-2, info.overlap, 0.5));
+    info = find_gjk_collision(circle2, circle1);
+    assert(vec_within(0.05, info.axis, (Vector) {-1, 0}));
+
+    // Apart, the axis separating them is reported
+    polygon_translate(circle2, (Vector) {0, 1.5});
+    info = find_gjk_collision(circle1, circle2);
+    assert(!info.collided);
+    double max1 = -INFINITY, min2 = INFINITY;
+    for (size_t i = 0; i < 64; i++) {
+        max1 = fmax(max1, vec_dot(polygon_get(circle1, i), info.axis));
+        min2 = fmin(min2, vec_dot(polygon_get(circle2, i), info.axis));
+    }
+    assert(max1 < min2);
+    // Large pairs go through GJK from find_collision() too
+    assert(!find_collision(circle1, circle2).collided);
+    polygon_translate(circle2, (Vector) {0, -1});
+    assert(find_collision(circle1, circle2).collided);
+
+    // Boxes give exact depths
+    Polygon *box1 = make_regular(4, (Vector) {0, 0}, sqrt(2));
+    polygon_rotate(box1, M_PI / 4, VEC_ZERO);
+    Polygon *box2 = make_regular(4, (Vector) {0.5, 1.75}, sqrt(2));
+    polygon_rotate(box2, M_PI / 4, (Vector) {0.5, 1.75});
+    info = find_gjk_collision(box1, box2);
+    assert(info.collided);
+    assert(vec_isclose(info.axis, (Vector) {0, 1}));
+    assert(isclose(info.overlap, 0.25));
+
+    polygon_free(circle1);
+    polygon_free(circle2);
+    polygon_free(box1);
+    polygon_free(box2);
+}
+
+void test_gjk_matches_sat() {
+    Polygon *hexagon = make_regular(6, (Vector) {0, 0}, 2);
+    for (int x = -8; x <= 8; x++) {
+        for (int y = -8; y <= 8; y++) {
+            Polygon *pentagon = make_regular(5, (Vector) {x * 0.5 + 0.01, y * 0.5 - 0.02}, 1.5);
+            CollisionInfo sat = find_collision(hexagon, pentagon);
+            CollisionInfo gjk = find_gjk_collision(hexagon, pentagon);
+            assert(sat.collided == gjk.collided);
+            if (gjk.collided) {
+                assert(gjk.overlap >= 0);
+                assert(isclose(vec_dot(gjk.axis, gjk.axis), 1));
+            }
+            polygon_free(pentagon);
+        }
+    }
+    polygon_free(hexagon);
+}
+
+// Makes a regular polygon turned by an angle about its center
+Polygon *make_turned(size_t sides, Vector center, double radius, double turn) {
+    Polygon *shape = make_regular(sides, center, radius);
+    polygon_rotate(shape, turn, center);
+    return shape;
+}
+
+void test_gjk_near_touching() {
+    // Pairs moved apart until SAT only just finds a gap between them. On
+    // these, GJK stops getting any closer to the origin without enclosing it,
+    // in double builds for the first half and float builds for the second;
+    // it must then report the pair as apart rather than go on to EPA.
+    size_t pairs[] = {630, 785, 897, 978, 1785, 2014, 70, 184, 800, 1030, 1275, 1395};
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        size_t k = pairs[p];
+        size_t sides1 = 5 + k % 5, sides2 = 5 + (k / 5) % 5;
+        double radius1 = 1 + 0.01 * (k % 97), radius2 = 1 + 0.01 * (k % 89);
+        double turn = 0.1 * k, angle = 0.37 * k;
+        Vector direction = {cos(angle), sin(angle)};
+        Polygon *shape1 = make_regular(sides1, VEC_ZERO, radius1);
+        double apart = radius1 + radius2 + 1, overlapping = 0;
+        for (size_t i = 0; i < 100; i++) {
+            double middle = (apart + overlapping) / 2;
+            Polygon *shape2 = make_turned(sides2, vec_multiply(middle, direction), radius2, turn);
+            if (find_collision(shape1, shape2).collided) {
+                overlapping = middle;
+            }
+            else {
+                apart = middle;
+            }
+            polygon_free(shape2);
+        }
+        Polygon *shape2 = make_turned(sides2, vec_multiply(apart, direction), radius2, turn);
+        assert(!find_collision(shape1, shape2).collided);
+        CollisionInfo info = find_gjk_collision(shape1, shape2);
+        assert(!info.collided);
+        assert(isclose(vec_dot(info.axis, info.axis), 1));
+        polygon_free(shape1);
+        polygon_free(shape2);
+    }
+}
+
 int main(int argc, char *argv[]) {
     // Run all tests if there are no command-line arguments
     bool all_tests = argc == 1;
@@ -151,6 +447,18 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_corner_collision)
     DO_TEST(test_inside_collision)
     DO_TEST(test_same_collision)
+    DO_TEST(test_circle_collision)
+    DO_TEST(test_circle_polygon_collision)
+    DO_TEST(test_body_circle_collision)
+    DO_TEST(test_box_collision)
+    DO_TEST(test_box_polygon_collision)
+    DO_TEST(test_circle_box_collision)
+    DO_TEST(test_body_box_collision)
+    DO_TEST(test_separating_axis_cache)
+    DO_TEST(test_gjk_collision)
+    DO_TEST(test_gjk_matches_sat)
+    DO_TEST(test_gjk_near_touching)
+    DO_TEST(test_star_piece_collision)
 
     puts("collision_test PASS");
 
@@ -4,20 +4,12 @@
 #include <math.h>
 #include <stdlib.h>
 
-List *make_shape() {
-    List *shape = list_init(4, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {-1, -1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, -1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {+1, +1};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-1, +1};
-    list_add(shape, v);
+Polygon *make_shape() {
+    Polygon *shape = polygon_init(4);
+    polygon_add(shape, (Vector) {-1, -1});
+    polygon_add(shape, (Vector) {+1, -1});
+    polygon_add(shape, (Vector) {+1, +1});
+    polygon_add(shape, (Vector) {-1, +1});
     return shape;
 }
 
@@ -26,13 +18,13 @@ void test_spring_sinusoid() {
     const double M = 10;
     const double K = 2;
     const double A = 3;
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
     Scene *scene = scene_init();
-    Body *mass = body_init(make_shape(), M, (RGBColor) {0, 0, 0});
+    Body *mass = body_init(make_shape(), M, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(mass, (Vector) {A, 0});
     scene_add_body(scene, mass);
-    Body *anchor = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0});
+    Body *anchor = body_init(make_shape(), INFINITY, (RGBColor) {0, 0, 0}, 1);
     scene_add_body(scene, anchor);
     create_spring(scene, K, mass, anchor);
     for (int i = 0; i < STEPS; i++) {
@@ -58,12 +50,12 @@ double kinetic_energy(Body *body) {
 void test_energy_conservation() {
     const double M1 = 4.5, M2 = 7.3;
     const double G = 1e3;
-    const double DT = 1e-6;
-    const int STEPS = 1000000;
+    const double DT = TEST_DT;
+    const int STEPS = TEST_STEPS;
     Scene *scene = scene_init();
-    Body *mass1 = body_init(make_shape(), M1, (RGBColor) {0, 0, 0});
+    Body *mass1 = body_init(make_shape(), M1, (RGBColor) {0, 0, 0}, 1);
     scene_add_body(scene, mass1);
-    Body *mass2 = body_init(make_shape(), M2, (RGBColor) {0, 0, 0});
+    Body *mass2 = body_init(make_shape(), M2, (RGBColor) {0, 0, 0}, 1);
     body_set_centroid(mass2, (Vector) {10, 20});
     scene_add_body(scene, mass2);
     create_newtonian_gravity(scene, G, mass1, mass2);
@@ -72,24 +64,18 @@ void test_energy_conservation() {
         assert(body_get_centroid(mass1).x < body_get_centroid(mass2).x);
         double energy = gravity_potential(G, mass1, mass2) +
             kinetic_energy(mass1) + kinetic_energy(mass2);
-        assert(within(1e-5, energy / initial_energy, 1));
+        assert(within(1e-5 + TEST_DRIFT, energy / initial_energy, 1));
         scene_tick(scene, DT);
     }
     scene_free(scene);
 }
 
 Body *make_triangle_body() {
-    List *shape = list_init(3, free);
-    Vector *v = malloc(sizeof(*v));
-    *v = (Vector) {1, 0};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-0.5, +sqrt(3) / 2};
-    list_add(shape, v);
-    v = malloc(sizeof(*v));
-    *v = (Vector) {-0.5, -sqrt(3) / 2};
-    list_add(shape, v);
-    return body_init(shape, 1, (RGBColor) {0, 0, 0});
+    Polygon *shape = polygon_init(3);
+    polygon_add(shape, (Vector) {1, 0});
+    polygon_add(shape, (Vector) {-0.5, +sqrt(3) / 2});
+    polygon_add(shape, (Vector) {-0.5, -sqrt(3) / 2});
+    return body_init(shape, 1, (RGBColor) {0, 0, 0}, 1);
 }
 
 // Tests that destructive collisions remove bodies from the scene
@@ -131,12 +117,56 @@ void test_collisions() {
     scene_free(scene);
 }
 
+// Remembers the axes a collision handler was called with
+typedef struct axis_record {
+    size_t calls;
+    Vector axis;
+} AxisRecord;
+
+void record_axis(Body *body1, Body *body2, Vector axis, void *aux) {
+    AxisRecord *record = aux;
+    record->calls++;
+    record->axis = axis;
+}
+
+// Tests that collisions created more than once for a pair of bodies share
+// one check per tick, in whichever order the bodies were given
+void test_duplicate_collisions() {
+    Scene *scene = scene_init();
+    Body *body1 = body_init(make_shape(), 1, (RGBColor) {0, 0, 0}, 1);
+    Body *body2 = body_init(make_shape(), 1, (RGBColor) {0, 0, 0}, 1);
+    body_set_centroid(body2, (Vector) {1.5, 0.5});
+    scene_add_body(scene, body1);
+    scene_add_body(scene, body2);
+    AxisRecord *forward = calloc(1, sizeof(AxisRecord));
+    AxisRecord *again = calloc(1, sizeof(AxisRecord));
+    AxisRecord *backward = calloc(1, sizeof(AxisRecord));
+    create_collision(scene, body1, body2, record_axis, forward, free);
+    assert(scene_get_duplicate_collisions(scene) == 0);
+    create_collision(scene, body1, body2, record_axis, again, free);
+    create_collision(scene, body2, body1, record_axis, backward, free);
+    assert(scene_get_duplicate_collisions(scene) == 2);
+
+    separating_axis_reset_stats();
+    scene_tick(scene, 0);
+    assert(separating_axis_get_stats().full_checks == 1);
+    assert(forward->calls == 1 && again->calls == 1 && backward->calls == 1);
+    assert(vec_isclose(forward->axis, (Vector) {1, 0}));
+    assert(vec_isclose(again->axis, forward->axis));
+    assert(vec_isclose(backward->axis, vec_negate(forward->axis)));
+
+    // Each handler is still only called when the collision starts
+    scene_tick(scene, 0);
+    assert(forward->calls == 1 && backward->calls == 1);
+    scene_free(scene);
+}
+
 // Tests that force creators properly register their list of affected bodies.
 // If they don't, asan will report a heap-use-after-free failure.
 void test_forces_removed() {
     Scene *scene = scene_init();
     for (int i = 0; i < 10; i++) {
-        Body *body = body_init(make_shape(), 1, (RGBColor) {0, 0, 0});
+        Body *body = body_init(make_shape(), 1, (RGBColor) {0, 0, 0}, 1);
         body_set_centroid(body, (Vector) {i, i});
         scene_add_body(scene, body);
         for (int j = 0; j < i; j++) {
@@ -165,6 +195,7 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_energy_conservation)
     DO_TEST(test_collisions)
     DO_TEST(test_forces_removed)
+    DO_TEST(test_duplicate_collisions)
 
     puts("forces_test PASS");
     return 0;
@@ -3,6 +3,7 @@
 #include "list.h"
 #include <assert.h>
 #include <math.h>
+#include <stdlib.h>
 
 
 /*
@@ -69,6 +70,67 @@ void test_layered_free() {
 }
 */
 
+// Makes a list holding the ints 0, 1, ..., n - 1
+List *make_int_list(size_t n) {
+    List *list = list_init(n, free);
+    for (size_t i = 0; i < n; i++) {
+        int *value = malloc(sizeof(*value));
+        *value = i;
+        list_add(list, value);
+    }
+    return list;
+}
+
+bool is_odd(void *value) {
+    return *(int *) value % 2 == 1;
+}
+
+void test_swap_remove() {
+    List *list = make_int_list(5);
+    int *removed = list_swap_remove(list, 1);
+    assert(*removed == 1);
+    free(removed);
+    assert(list_size(list) == 4);
+    assert(*(int *) list_get(list, 0) == 0);
+    assert(*(int *) list_get(list, 1) == 4);
+    assert(*(int *) list_get(list, 2) == 2);
+    assert(*(int *) list_get(list, 3) == 3);
+    // Removing the last element leaves the rest untouched
+    removed = list_swap_remove(list, 3);
+    assert(*removed == 3);
+    free(removed);
+    assert(list_size(list) == 3);
+    assert(*(int *) list_get(list, 2) == 2);
+    list_free(list);
+}
+
+void test_remove_if_ordered() {
+    List *list = make_int_list(10);
+    assert(list_remove_if(list, is_odd, free, true) == 5);
+    assert(list_size(list) == 5);
+    for (size_t i = 0; i < 5; i++) {
+        assert(*(int *) list_get(list, i) == 2 * i);
+    }
+    assert(list_remove_if(list, is_odd, free, true) == 0);
+    list_free(list);
+}
+
+void test_remove_if_unordered() {
+    List *list = make_int_list(10);
+    assert(list_remove_if(list, is_odd, free, false) == 5);
+    assert(list_size(list) == 5);
+    int seen = 0;
+    for (size_t i = 0; i < 5; i++) {
+        int value = *(int *) list_get(list, i);
+        assert(value % 2 == 0);
+        seen |= 1 << value;
+    }
+    assert(seen == (1 << 0 | 1 << 2 | 1 << 4 | 1 << 6 | 1 << 8));
+    // Elements before the first removed one never move
+    assert(*(int *) list_get(list, 0) == 0);
+    list_free(list);
+}
+
 int main(int argc, char *argv[]) {
     // Run all tests if there are no command-line arguments
     bool all_tests = argc == 1;
@@ -83,6 +145,9 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_overflow)
     DO_TEST(test_layered_free)
 */
+    DO_TEST(test_swap_remove)
+    DO_TEST(test_remove_if_ordered)
+    DO_TEST(test_remove_if_unordered)
 
 
 
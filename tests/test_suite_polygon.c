@@ -5,207 +5,263 @@
 #include <math.h>
 #include <stdbool.h>
 
-Vector *make_vector(double x, double y){
-  Vector *v = malloc(sizeof(Vector));
-  v->x = x;
-  v->y = y;
-  return v;
-}
-
 // Make square at (+/-1, +/-1)
-List *make_square() {
-    List *sq = list_init(4, (FreeFunc) free);
-    Vector *v1 = make_vector(1, 1);
-    Vector *v2 = make_vector(-1, 1);
-    Vector *v3 = make_vector(-1, -1);
-    Vector *v4 = make_vector(1, -1);
-    list_add(sq, v1);
-    list_add(sq, v2);
-    list_add(sq, v3);
-    list_add(sq, v4);
+Polygon *make_square() {
+    Polygon *sq = polygon_init(4);
+    polygon_add(sq, (Vector){1, 1});
+    polygon_add(sq, (Vector){-1, 1});
+    polygon_add(sq, (Vector){-1, -1});
+    polygon_add(sq, (Vector){1, -1});
     return sq;
 }
 
 void test_square_area_centroid() {
-    List *sq = make_square();
+    Polygon *sq = make_square();
     assert(isclose(polygon_area(sq), 4));
     assert(vec_isclose(polygon_centroid(sq), VEC_ZERO));
-    list_free(sq);
+    polygon_free(sq);
 }
 
 void test_square_translate() {
-    List *sq = make_square();
+    Polygon *sq = make_square();
     polygon_translate(sq, (Vector){2, 3});
-    assert(vec_equal(*(Vector*)list_get(sq, 0), (Vector){3, 4}));
-    assert(vec_equal(*(Vector*)list_get(sq, 1), (Vector){1, 4}));
-    assert(vec_equal(*(Vector*)list_get(sq, 2), (Vector){1, 2}));
-    assert(vec_equal(*(Vector*)list_get(sq, 3), (Vector){3, 2}));
+    assert(vec_equal(polygon_get(sq, 0), (Vector){3, 4}));
+    assert(vec_equal(polygon_get(sq, 1), (Vector){1, 4}));
+    assert(vec_equal(polygon_get(sq, 2), (Vector){1, 2}));
+    assert(vec_equal(polygon_get(sq, 3), (Vector){3, 2}));
     assert(isclose(polygon_area(sq), 4));
     assert(vec_isclose(polygon_centroid(sq), (Vector){2, 3}));
-    list_free(sq);
+    polygon_free(sq);
 }
 
 void test_square_rotate() {
-    List *sq = make_square();
+    Polygon *sq = make_square();
     polygon_rotate(sq, 0.25 * M_PI, VEC_ZERO);
-    assert(vec_isclose(*(Vector*)list_get(sq, 0), (Vector){0, sqrt(2)}));
-    assert(vec_isclose(*(Vector*)list_get(sq, 1), (Vector){-sqrt(2), 0}));
-    assert(vec_isclose(*(Vector*)list_get(sq, 2), (Vector){0, -sqrt(2)}));
-    assert(vec_isclose(*(Vector*)list_get(sq, 3), (Vector){sqrt(2), 0}));
+    assert(vec_isclose(polygon_get(sq, 0), (Vector){0, sqrt(2)}));
+    assert(vec_isclose(polygon_get(sq, 1), (Vector){-sqrt(2), 0}));
+    assert(vec_isclose(polygon_get(sq, 2), (Vector){0, -sqrt(2)}));
+    assert(vec_isclose(polygon_get(sq, 3), (Vector){sqrt(2), 0}));
     assert(isclose(polygon_area(sq), 4));
     assert(vec_isclose(polygon_centroid(sq), VEC_ZERO));
-    list_free(sq);
+    polygon_free(sq);
 }
 
 // Make 3-4-5 triangle
-List *make_triangle() {
-    List *tri = list_init(3, free);
-    Vector *v1 = make_vector(0, 0);
-    Vector *v2 = make_vector(4, 0);
-    Vector *v3 = make_vector(4, 3);
-    list_add(tri, v1);
-    list_add(tri, v2);
-    list_add(tri, v3);
+Polygon *make_triangle() {
+    Polygon *tri = polygon_init(3);
+    polygon_add(tri, (Vector){0, 0});
+    polygon_add(tri, (Vector){4, 0});
+    polygon_add(tri, (Vector){4, 3});
     return tri;
 }
 
 void test_triangle_area_centroid() {
-    List *tri = make_triangle();
+    Polygon *tri = make_triangle();
     assert(isclose(polygon_area(tri), 6));
     assert(vec_isclose(polygon_centroid(tri), (Vector){8.0 / 3.0, 1}));
-    list_free(tri);
+    polygon_free(tri);
 }
 
 void test_triangle_translate() {
-    List *tri = make_triangle();
+    Polygon *tri = make_triangle();
     polygon_translate(tri, (Vector){-4, -3});
-    assert(vec_equal(*(Vector*)list_get(tri, 0), (Vector){-4, -3}));
-    assert(vec_equal(*(Vector*)list_get(tri, 1), (Vector){0,  -3}));
-    assert(vec_equal(*(Vector*)list_get(tri, 2), (Vector){0,  0}));
+    assert(vec_equal(polygon_get(tri, 0), (Vector){-4, -3}));
+    assert(vec_equal(polygon_get(tri, 1), (Vector){0,  -3}));
+    assert(vec_equal(polygon_get(tri, 2), (Vector){0,  0}));
     assert(isclose(polygon_area(tri), 6));
     assert(vec_isclose(polygon_centroid(tri), (Vector){-4.0 / 3.0, -2}));
-    list_free(tri);
+    polygon_free(tri);
 }
 
 void test_triangle_rotate() {
-    List *tri = make_triangle();
+    Polygon *tri = make_triangle();
 
     // Rotate -acos(4/5) degrees around (4,3)
     polygon_rotate(tri, 2 * M_PI - acos(4.0 / 5.0), (Vector){4, 3});
-    assert(vec_isclose(*(Vector*)list_get(tri, 0), (Vector){-1,  3}));
-    assert(vec_isclose(*(Vector*)list_get(tri, 1), (Vector){2.2, 0.6}));
-    assert(vec_isclose(*(Vector*)list_get(tri, 2), (Vector){4,   3}));
+    assert(vec_isclose(polygon_get(tri, 0), (Vector){-1,  3}));
+    assert(vec_isclose(polygon_get(tri, 1), (Vector){2.2, 0.6}));
+    assert(vec_isclose(polygon_get(tri, 2), (Vector){4,   3}));
     assert(isclose(polygon_area(tri), 6));
     assert(vec_isclose(polygon_centroid(tri), (Vector){26.0 / 15.0, 2.2}));
 
-    list_free(tri);
+    polygon_free(tri);
 }
 
+// Single precision cannot tell apart a million points on a unit circle
+#ifdef SCALAR_FLOAT
+#define CIRC_NPOINTS 10000
+#else
 #define CIRC_NPOINTS 1000000
+#endif
 #define CIRC_AREA (CIRC_NPOINTS * sin(2 * M_PI / CIRC_NPOINTS) / 2)
 
 // Circle with many points (stress test)
-List *make_big_circ() {
-    List *c = list_init(CIRC_NPOINTS, free);
+Polygon *make_big_circ() {
+    Polygon *c = polygon_init(CIRC_NPOINTS);
     for (size_t i = 0; i < CIRC_NPOINTS; i++) {
         double angle = 2 * M_PI * i / CIRC_NPOINTS;
-        list_add(c, make_vector(cos(angle), sin(angle)));
+        polygon_add(c, (Vector){cos(angle), sin(angle)});
     }
     return c;
 }
 
 void test_circ_area_centroid() {
-    List *c = make_big_circ();
+    Polygon *c = make_big_circ();
     assert(isclose(polygon_area(c), CIRC_AREA));
     assert(vec_isclose(polygon_centroid(c), VEC_ZERO));
-    list_free(c);
+    polygon_free(c);
 }
 
 void test_circ_translate() {
-    List *c = make_big_circ();
+    Polygon *c = make_big_circ();
     Vector translation = {.x = 100, .y = 200};
     polygon_translate(c, translation);
 
     for (size_t i = 0; i < CIRC_NPOINTS; i++) {
         double angle = 2 * M_PI * i / CIRC_NPOINTS;
         assert(vec_isclose(
-            *(Vector*)list_get(c, i),
+            polygon_get(c, i),
             vec_add(translation, (Vector){cos(angle), sin(angle)})
         ));
     }
     assert(isclose(polygon_area(c), CIRC_AREA));
     assert(vec_isclose(polygon_centroid(c), translation));
 
-    list_free(c);
+    polygon_free(c);
 }
 
 void test_circ_rotate() {
     // Rotate about the origin at an unusual angle
     const double rot_angle = 0.5;
 
-    List *c = make_big_circ();
+    Polygon *c = make_big_circ();
     polygon_rotate(c, rot_angle, VEC_ZERO);
 
     for (size_t i = 0; i < CIRC_NPOINTS; i++) {
         double angle = 2 * M_PI * i / CIRC_NPOINTS;
         assert(vec_isclose(
-            *(Vector*)list_get(c, i),
+            polygon_get(c, i),
             (Vector){cos(angle + rot_angle), sin(angle + rot_angle)})
         );
     }
     assert(isclose(polygon_area(c), CIRC_AREA));
     assert(vec_isclose(polygon_centroid(c), VEC_ZERO));
 
-    list_free(c);
+    polygon_free(c);
 }
 
 // Weird nonconvex polygon
-List *make_weird() {
-    List *w = list_init(5, free);
-    list_add(w, make_vector(0,  0));
-    list_add(w, make_vector(4,  1));
-    list_add(w, make_vector(-2, 1));
-    list_add(w, make_vector(-5, 5));
-    list_add(w, make_vector(-1, -8));
+Polygon *make_weird() {
+    Polygon *w = polygon_init(5);
+    polygon_add(w, (Vector){0, 0});
+    polygon_add(w, (Vector){4, 1});
+    polygon_add(w, (Vector){-2, 1});
+    polygon_add(w, (Vector){-5, 5});
+    polygon_add(w, (Vector){-1, -8});
     return w;
 }
 
 void test_weird_area_centroid() {
-    List *w = make_weird();
+    Polygon *w = make_weird();
     assert(isclose(polygon_area(w), 23));
     assert(vec_isclose(polygon_centroid(w), (Vector){-223.0 / 138.0, -51.0 / 46.0}));
-    list_free(w);
+    polygon_free(w);
 }
 
 void test_weird_translate() {
-    List *w = make_weird();
+    Polygon *w = make_weird();
     polygon_translate(w, (Vector){-10, -20});
 
-    assert(vec_isclose(*(Vector*)list_get(w, 0), (Vector){-10, -20}));
-    assert(vec_isclose(*(Vector*)list_get(w, 1), (Vector){-6,  -19}));
-    assert(vec_isclose(*(Vector*)list_get(w, 2), (Vector){-12, -19}));
-    assert(vec_isclose(*(Vector*)list_get(w, 3), (Vector){-15, -15}));
-    assert(vec_isclose(*(Vector*)list_get(w, 4), (Vector){-11, -28}));
+    assert(vec_isclose(polygon_get(w, 0), (Vector){-10, -20}));
+    assert(vec_isclose(polygon_get(w, 1), (Vector){-6,  -19}));
+    assert(vec_isclose(polygon_get(w, 2), (Vector){-12, -19}));
+    assert(vec_isclose(polygon_get(w, 3), (Vector){-15, -15}));
+    assert(vec_isclose(polygon_get(w, 4), (Vector){-11, -28}));
     assert(isclose(polygon_area(w), 23));
     assert(vec_isclose(polygon_centroid(w), (Vector){-1603.0 / 138.0, -971.0 / 46.0}));
 
-    list_free(w);
+    polygon_free(w);
 }
 
 void test_weird_rotate() {
-    List *w = make_weird();
+    Polygon *w = make_weird();
     // Rotate 90 degrees around (0, 2)
     polygon_rotate(w, M_PI / 2, (Vector){0, 2});
 
-    assert(vec_isclose(*(Vector*)list_get(w, 0), (Vector){2,  2}));
-    assert(vec_isclose(*(Vector*)list_get(w, 1), (Vector){1,  6}));
-    assert(vec_isclose(*(Vector*)list_get(w, 2), (Vector){1,  0}));
-    assert(vec_isclose(*(Vector*)list_get(w, 3), (Vector){-3, -3}));
-    assert(vec_isclose(*(Vector*)list_get(w, 4), (Vector){10, 1}));
+    assert(vec_isclose(polygon_get(w, 0), (Vector){2,  2}));
+    assert(vec_isclose(polygon_get(w, 1), (Vector){1,  6}));
+    assert(vec_isclose(polygon_get(w, 2), (Vector){1,  0}));
+    assert(vec_isclose(polygon_get(w, 3), (Vector){-3, -3}));
+    assert(vec_isclose(polygon_get(w, 4), (Vector){10, 1}));
     assert(isclose(polygon_area(w), 23));
     assert(vec_isclose(polygon_centroid(w), (Vector){143.0 / 46.0, 53.0 / 138.0}));
 
-    list_free(w);
+    polygon_free(w);
+}
+
+void test_simplify() {
+    // A square with a vertex halfway along each side, and one bump
+    Polygon *p = polygon_init(9);
+    polygon_add(p, (Vector){1, 1});
+    polygon_add(p, (Vector){0, 1});
+    polygon_add(p, (Vector){-1, 1});
+    polygon_add(p, (Vector){-1, 0});
+    polygon_add(p, (Vector){-1, -1});
+    polygon_add(p, (Vector){0, -1});
+    polygon_add(p, (Vector){1, -1});
+    polygon_add(p, (Vector){1.01, -0.5});
+    polygon_add(p, (Vector){1, 0});
+
+    // Only the collinear vertices are dropped without any tolerance
+    Polygon *exact = polygon_simplify(p, 3, 0);
+    assert(polygon_size(exact) == 6);
+    assert(vec_isclose(polygon_get(exact, 0), (Vector){1, 1}));
+    assert(vec_isclose(polygon_get(exact, 1), (Vector){-1, 1}));
+    assert(vec_isclose(polygon_get(exact, 4), (Vector){1.01, -0.5}));
+    assert(isclose(polygon_area(exact), polygon_area(p)));
+    polygon_free(exact);
+
+    // The bump is within the tolerance, so only the corners are left
+    Polygon *loose = polygon_simplify(p, 3, 0.1);
+    assert(polygon_size(loose) == 4);
+    assert(isclose(polygon_area(loose), 4));
+    polygon_free(loose);
+
+    // A vertex count target stops early, or keeps going past the tolerance
+    Polygon *counted = polygon_simplify(p, 7, INFINITY);
+    assert(polygon_size(counted) == 7);
+    polygon_free(counted);
+    Polygon *triangle = polygon_simplify(p, 0, INFINITY);
+    assert(polygon_size(triangle) == 3);
+    polygon_free(triangle);
+
+    polygon_free(p);
+}
+
+void test_edge_normals() {
+    Vector normals[6];
+    // Opposite sides of a square share an axis
+    Polygon *sq = make_square();
+    assert(polygon_edge_normals(sq, normals) == 2);
+    assert(vec_isclose(normals[0], (Vector){0, 1}));
+    assert(vec_isclose(normals[1], (Vector){-1, 0}));
+    polygon_free(sq);
+
+    // The edge from the last vertex back to the first counts too
+    Polygon *triangle = polygon_init(3);
+    polygon_add(triangle, (Vector){0, 0});
+    polygon_add(triangle, (Vector){2, 0});
+    polygon_add(triangle, (Vector){0, 2});
+    assert(polygon_edge_normals(triangle, normals) == 3);
+    assert(vec_isclose(normals[2], (Vector){-1, 0}));
+    polygon_free(triangle);
+
+    Polygon *hexagon = polygon_init(6);
+    for (size_t i = 0; i < 6; i++) {
+        polygon_add(hexagon, (Vector){cos(i * M_PI / 3), sin(i * M_PI / 3)});
+    }
+    assert(polygon_edge_normals(hexagon, normals) == 3);
+    polygon_free(hexagon);
 }
 
 int main(int argc, char *argv[]) {
@@ -229,6 +285,8 @@ int main(int argc, char *argv[]) {
     DO_TEST(test_weird_area_centroid)
     DO_TEST(test_weird_translate)
     DO_TEST(test_weird_rotate)
+    DO_TEST(test_simplify)
+    DO_TEST(test_edge_normals)
 
     puts("polygon_test PASS");
 
@@ -0,0 +1,74 @@
+#include "test_util.h"
+#include "pool.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+void test_pool_reuse() {
+    Pool *pool = pool_init("test_reuse", sizeof(double), 4);
+    double *a = pool_alloc(pool);
+    double *b = pool_alloc(pool);
+    assert(a != b);
+    *a = 1.0;
+    *b = 2.0;
+    pool_release(pool, a);
+    // The released object is handed out again before the pool grows
+    double *c = pool_alloc(pool);
+    assert(c == a);
+    assert(*b == 2.0);
+    PoolStats stats = pool_get_stats(pool);
+    assert(stats.in_use == 2);
+    assert(stats.peak_in_use == 2);
+    assert(stats.total_allocs == 3);
+    assert(stats.blocks == 1);
+    assert(stats.capacity == 4);
+    pool_free(pool);
+}
+
+void test_pool_grow() {
+    Pool *pool = pool_init("test_grow", 24, 3);
+    void *objects[10];
+    for (size_t i = 0; i < 10; i++) {
+        objects[i] = pool_alloc(pool);
+        assert((uintptr_t) objects[i] % 16 == 0);
+    }
+    PoolStats stats = pool_get_stats(pool);
+    assert(stats.blocks == 4);
+    assert(stats.capacity == 12);
+    for (size_t i = 0; i < 10; i++) {
+        pool_release(pool, objects[i]);
+    }
+    stats = pool_get_stats(pool);
+    assert(stats.in_use == 0);
+    assert(stats.peak_in_use == 10);
+    pool_free(pool);
+}
+
+void test_pool_find() {
+    Pool *first = pool_init("test_first", 8, 1);
+    Pool *second = pool_init("test_second", 8, 1);
+    assert(pool_find("test_first") == first);
+    assert(pool_find("test_second") == second);
+    pool_free(first);
+    assert(pool_find("test_first") == NULL);
+    assert(pool_find("test_second") == second);
+    pool_free(second);
+}
+
+int main(int argc, char *argv[]) {
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_pool_reuse)
+    DO_TEST(test_pool_grow)
+    DO_TEST(test_pool_find)
+
+    puts("pool_test PASS");
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "test_util.h"
+#include "simd.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define MAX_VERTICES 9
+
+// Fills vertices with an irregular but deterministic shape
+void make_vertices(Vector *vertices, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        vertices[i] = (Vector) {cos(i * 1.3) * (i + 2), sin(i * 0.7) * (3 - (double) i)};
+    }
+}
+
+// Every size is tested so that each remainder of the vector width is covered
+void test_simd_translate() {
+    for (size_t size = 1; size <= MAX_VERTICES; size++) {
+        Vector vertices[MAX_VERTICES];
+        make_vertices(vertices, size);
+        simd_translate(vertices, size, (Vector) {1.5, -2});
+        Vector expected[MAX_VERTICES];
+        make_vertices(expected, size);
+        for (size_t i = 0; i < size; i++) {
+            assert(vec_equal(vertices[i], vec_add(expected[i], (Vector) {1.5, -2})));
+        }
+    }
+}
+
+void test_simd_transform() {
+    double angle = 0.8;
+    Vector translation = {3, -1};
+    for (size_t size = 1; size <= MAX_VERTICES; size++) {
+        Vector vertices[MAX_VERTICES];
+        make_vertices(vertices, size);
+        simd_transform(vertices, vertices, size, cos(angle), sin(angle), translation);
+        Vector expected[MAX_VERTICES];
+        make_vertices(expected, size);
+        for (size_t i = 0; i < size; i++) {
+            Vector transformed = vec_add(vec_rotate(expected[i], angle), translation);
+            assert(vec_isclose(vertices[i], transformed));
+        }
+    }
+}
+
+void test_simd_project() {
+    Vector axis = {0.6, 0.8};
+    for (size_t size = 1; size <= MAX_VERTICES; size++) {
+        Vector vertices[MAX_VERTICES];
+        make_vertices(vertices, size);
+        Scalar min, max;
+        simd_project(vertices, size, axis, &min, &max);
+        Scalar expected_min = INFINITY, expected_max = -INFINITY;
+        for (size_t i = 0; i < size; i++) {
+            Scalar p = vec_dot(axis, vertices[i]);
+            expected_min = fmin(expected_min, p);
+            expected_max = fmax(expected_max, p);
+        }
+        assert(min == expected_min);
+        assert(max == expected_max);
+    }
+}
+
+void test_simd_bounds() {
+    for (size_t size = 1; size <= MAX_VERTICES; size++) {
+        Vector vertices[MAX_VERTICES];
+        make_vertices(vertices, size);
+        Vector min, max;
+        simd_bounds(vertices, size, &min, &max);
+        Vector expected_min = vertices[0], expected_max = vertices[0];
+        for (size_t i = 0; i < size; i++) {
+            expected_min.x = fmin(expected_min.x, vertices[i].x);
+            expected_min.y = fmin(expected_min.y, vertices[i].y);
+            expected_max.x = fmax(expected_max.x, vertices[i].x);
+            expected_max.y = fmax(expected_max.y, vertices[i].y);
+        }
+        assert(vec_equal(min, expected_min));
+        assert(vec_equal(max, expected_max));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_simd_translate)
+    DO_TEST(test_simd_transform)
+    DO_TEST(test_simd_project)
+    DO_TEST(test_simd_bounds)
+
+    puts("simd_test PASS");
+
+    return 0;
+}
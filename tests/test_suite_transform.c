@@ -0,0 +1,81 @@
+#include "test_util.h"
+#include "transform.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+void test_transform_rotation() {
+    Transform2D rotation = transform_rotation(M_PI / 2, (Vector) {1, 1});
+    // The point rotated around stays fixed
+    assert(vec_isclose(transform_apply(rotation, (Vector) {1, 1}), (Vector) {1, 1}));
+    assert(vec_isclose(transform_apply(rotation, (Vector) {2, 1}), (Vector) {1, 2}));
+    assert(vec_isclose(transform_apply(rotation, (Vector) {1, 3}), (Vector) {-1, 1}));
+    assert(vec_isclose(
+        transform_apply(transform_rotation(0.3, VEC_ZERO), (Vector) {4, -2}),
+        vec_rotate((Vector) {4, -2}, 0.3)
+    ));
+}
+
+void test_transform_translation() {
+    Transform2D translation = transform_translation((Vector) {3, -4});
+    assert(vec_equal(transform_apply(translation, (Vector) {1, 1}), (Vector) {4, -3}));
+    assert(vec_equal(transform_apply(TRANSFORM_IDENTITY, (Vector) {1, 1}), (Vector) {1, 1}));
+}
+
+void test_transform_compose() {
+    Transform2D rotate = transform_rotation(0.7, (Vector) {2, -1});
+    Transform2D translate = transform_translation((Vector) {-5, 6});
+    Transform2D rotate_again = transform_rotation(-1.9, (Vector) {0, 3});
+    Transform2D combined = transform_compose(rotate_again, transform_compose(translate, rotate));
+    Vector v = {1.5, 2.5};
+    Vector expected =
+        transform_apply(rotate_again, transform_apply(translate, transform_apply(rotate, v)));
+    assert(vec_isclose(transform_apply(combined, v), expected));
+}
+
+void test_transform_invert() {
+    Transform2D transform =
+        transform_compose(transform_translation((Vector) {7, 8}), transform_rotation(2.2, (Vector) {-3, 1}));
+    Transform2D inverse = transform_invert(transform);
+    Vector v = {-2, 9};
+    assert(vec_isclose(transform_apply(inverse, transform_apply(transform, v)), v));
+    assert(vec_isclose(transform_apply(transform, transform_apply(inverse, v)), v));
+    Transform2D identity = transform_compose(inverse, transform);
+    assert(isclose(identity.cos_angle, 1));
+    assert(isclose(identity.sin_angle, 0));
+    assert(vec_isclose(identity.translation, VEC_ZERO));
+}
+
+void test_transform_apply_array() {
+    Transform2D transform =
+        transform_compose(transform_translation((Vector) {1, -1}), transform_rotation(1.1, (Vector) {2, 2}));
+    Vector vertices[5] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}, {-3, 4}};
+    Vector expected[5];
+    for (size_t i = 0; i < 5; i++) {
+        expected[i] = transform_apply(transform, vertices[i]);
+    }
+    transform_apply_array(transform, vertices, 5);
+    for (size_t i = 0; i < 5; i++) {
+        assert(vec_isclose(vertices[i], expected[i]));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // Run all tests if there are no command-line arguments
+    bool all_tests = argc == 1;
+    // Read test name from file
+    char testname[100];
+    if (!all_tests) {
+        read_testname(argv[1], testname, sizeof(testname));
+    }
+
+    DO_TEST(test_transform_rotation)
+    DO_TEST(test_transform_translation)
+    DO_TEST(test_transform_compose)
+    DO_TEST(test_transform_invert)
+    DO_TEST(test_transform_apply_array)
+
+    puts("transform_test PASS");
+
+    return 0;
+}